@@ -54,7 +54,7 @@ void CardAnimation::shuffleAnimation()
     CardAnimation::sleep(500);
 }
 
-void CardAnimation::dealCommunityCards(const std::vector<Card> &cards, const std::string &stage)
+void CardAnimation::dealCommunityCards(CardSpan cards, const std::string &stage)
 {
     // Choose color based on stage
     const char* stageColor = CYAN;
@@ -5,13 +5,14 @@
 #include <string>
 #include <vector>
 #include "../model/card.h"
+#include "../model/card_list.h"
 
 class CardAnimation
 {
 public:
     static void dealCardAnimation(const Card &card, bool faceUp = true);
     static void shuffleAnimation();
-    static void dealCommunityCards(const std::vector<Card> &cards, const std::string &stage);
+    static void dealCommunityCards(CardSpan cards, const std::string &stage);
     static void clearLine();
     static void sleep(int milliseconds);
 };
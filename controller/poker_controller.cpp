@@ -1,14 +1,12 @@
 #include "poker_controller.h"
-#include "../model/deck.h"
 #include "../model/player.h"
 #include "../model/hand_types.h"
-#include "../model/advanced_hand_evaluator.h"
+#include "../model/evaluator_registry.h"
 #include "../view/cli_view.h"
 #include "../animation/spinner.h"
 #include "../model/bot_player.h"
 
 #include <iostream>
-#include <vector>
 #include <string>
 #include <thread>
 #include <chrono>
@@ -23,10 +21,14 @@
 #define BLUE "\033[34m"
 #define MAGENTA "\033[35m"
 
-std::vector<Card> getCombinedHand(const Player &player, const std::vector<Card> &community)
+// Hole cards then board, on the stack
+FullHand getCombinedHand(const Player &player, CardSpan community)
 {
-    std::vector<Card> fullHand = player.getHand();
-    fullHand.insert(fullHand.end(), community.begin(), community.end());
+    FullHand fullHand;
+    for (const Card &c : player.getHand())
+        fullHand.push_back(c);
+    for (const Card &c : community)
+        fullHand.push_back(c);
     return fullHand;
 }
 
@@ -110,14 +112,14 @@ void PokerController::runGame()
 
 void PokerController::playRound(Player &human, Player &bot)
 {
-    Deck deck;
+    DealGenerator::Deal deal = deals.next();
     human.clearHand();
     bot.clearHand();
 
-    human.recieveCard(deck.dealCard());
-    human.recieveCard(deck.dealCard());
-    bot.recieveCard(deck.dealCard());
-    bot.recieveCard(deck.dealCard());
+    for (CardId id : deal.hole(0))
+        human.recieveCard(cardOf(id));
+    for (CardId id : deal.hole(1))
+        bot.recieveCard(cardOf(id));
 
     std::cout << "\n" << BOLD << GREEN << "Your Hand: " << RESET;
     human.showHand(true);
@@ -127,9 +129,9 @@ void PokerController::playRound(Player &human, Player &bot)
     CLIView::waitForEnter();
 
     // Flop
-    std::vector<Card> community;
+    CommunityCards community;
     for (int i = 0; i < 3; ++i)
-        community.push_back(deck.dealCard());
+        community.push_back(cardOf(deal.board(i)));
     CLIView::showCommunityCards(community, "Flop");
 
     // Bot decision making at flop stage
@@ -139,7 +141,7 @@ void PokerController::playRound(Player &human, Player &bot)
     }
 
     // Turn
-    community.push_back(deck.dealCard());
+    community.push_back(cardOf(deal.board(3)));
     CLIView::showCommunityCards(community, "Turn");
 
     if (!handleBetting(human, bot, community, GameStage::Turn))
@@ -148,7 +150,7 @@ void PokerController::playRound(Player &human, Player &bot)
     }
 
     // River
-    community.push_back(deck.dealCard());
+    community.push_back(cardOf(deal.board(4)));
     CLIView::showCommunityCards(community, "River");
 
     if (!handleBetting(human, bot, community, GameStage::River))
@@ -160,7 +162,7 @@ void PokerController::playRound(Player &human, Player &bot)
     showdown(human, bot, community);
 }
 
-bool PokerController::handleBetting(Player &human, Player &bot, const std::vector<Card> &community, GameStage stage)
+bool PokerController::handleBetting(Player &human, Player &bot, CardSpan community, GameStage stage)
 {
     CLIView::waitForEnter();
 
@@ -215,15 +217,19 @@ bool PokerController::handleBetting(Player &human, Player &bot, const std::vecto
     return true;
 }
 
-void PokerController::showdown(Player &human, Player &bot, const std::vector<Card> &community)
+void PokerController::showdown(Player &human, Player &bot, CardSpan community)
 {
     CLIView::showResult(human, bot, community);
 
-    auto humanFull = getCombinedHand(human, community);
-    auto botFull = getCombinedHand(bot, community);
-
-    HandValue hv1 = AdvancedHandEvaluator::evaluate(humanFull);
-    HandValue hv2 = AdvancedHandEvaluator::evaluate(botFull);
+    // Scored as one batch on the active backend, so POKER_EVALUATOR
+    // applies to real games too
+    const CardSet board = CardSet::fromCards(community);
+    const CardSet hands[2] = {board | CardSet::fromCards(human.getHand()),
+                              board | CardSet::fromCards(bot.getHand())};
+    uint32_t scores[2];
+    EvaluatorRegistry::active().evaluateBatch(hands, scores, 2);
+    HandValue hv1 = HandValue::fromScore(scores[0]);
+    HandValue hv2 = HandValue::fromScore(scores[1]);
 
     CLIView::showHandType(human.getName(), handRankToString(hv1.rank));
     CLIView::showHandType(bot.getName(), handRankToString(hv2.rank));
@@ -1,8 +1,10 @@
 #ifndef POKER_CONTROLLER_H
 #define POKER_CONTROLLER_H
 
+#include "../model/deal_generator.h"
 #include "../model/player.h"
 #include "../model/bot_player.h"
+#include "../model/card_list.h"
 
 class PokerController
 {
@@ -10,9 +12,13 @@ public:
     void runGame();
 
 private:
+    // Heads-up deals prepared in the background; seeded from the process
+    // seed so POKER_SEED replays the same hands
+    DealGenerator deals{2, Rng::nextStream()(), GameVariant::Holdem, 64};
+
     void playRound(Player &human, Player &bot);
-    bool handleBetting(Player &human, Player &bot, const std::vector<Card> &community, GameStage stage);
-    void showdown(Player &human, Player &bot, const std::vector<Card> &community);
+    bool handleBetting(Player &human, Player &bot, CardSpan community, GameStage stage);
+    void showdown(Player &human, Player &bot, CardSpan community);
 };
 
 #endif // Poker_CONTROLLER_H
\ No newline at end of file
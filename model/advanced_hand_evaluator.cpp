@@ -1,5 +1,8 @@
 // advanced_hand_evaluator.cpp
 #include "advanced_hand_evaluator.h"
+#include "evaluator_registry.h"
+#include "bitmask_hand_evaluator.h"
+#include "lookup_table_evaluator.h"
 #include <map>
 #include <algorithm>
 #include <stdexcept>
@@ -12,6 +15,17 @@ static int rankToInt(Rank r)
     return static_cast<int>(r);
 }
 
+/**
+ * Pack a rank and its ordered tiebreakers into a HandValue
+ */
+static HandValue makeValue(HandRank rank, const std::vector<int> &kickers)
+{
+    uint32_t score = static_cast<uint32_t>(rank) << HandValue::CATEGORY_SHIFT;
+    for (size_t i = 0; i < kickers.size() && i < 5; ++i)
+        score |= static_cast<uint32_t>(kickers[i]) << (16 - 4 * i);
+    return HandValue::fromScore(score);
+}
+
 /**
  * Check if the given ranks form a straight
  * 
@@ -33,7 +47,8 @@ static bool isStraight(const std::vector<int> &sortedRanks, int &highCard)
         uniqueRanks.insert(uniqueRanks.begin(), 1); // add ace as 1
     }
 
-    // Look for 5 consecutive ranks
+    // Look for 5 consecutive ranks, keeping the highest run found
+    bool found = false;
     int count = 1;
     for (size_t i = 1; i < uniqueRanks.size(); ++i)
     {
@@ -43,7 +58,7 @@ static bool isStraight(const std::vector<int> &sortedRanks, int &highCard)
             if (count >= 5)
             {
                 highCard = uniqueRanks[i];
-                return true;
+                found = true;
             }
         }
         else
@@ -52,20 +67,74 @@ static bool isStraight(const std::vector<int> &sortedRanks, int &highCard)
         }
     }
 
-    return false;
+    return found;
 }
 
 /**
  * Evaluate a poker hand and return its rank and kickers
  * 
  * This evaluator can handle more than 5 cards (e.g., 7 cards in Texas Hold'em)
- * and will find the best 5-card hand.
+ * and will find the best 5-card hand. Up to 7 cards go through
+ * EvaluatorRegistry::active(), so every caller scores with the same backend.
  * 
  * @param cards Vector of Card objects
  * @return HandValue containing the hand rank and kickers for tie-breaking
  * @throws std::invalid_argument if fewer than 5 cards are provided
  */
-HandValue AdvancedHandEvaluator::evaluate(const std::vector<Card> &cards)
+HandValue AdvancedHandEvaluator::evaluate(CardSpan cards)
+{
+    if (cards.size() < 5)
+    {
+        throw std::invalid_argument("At least 5 cards are required for hand evaluation");
+    }
+
+    const CardSet hand = CardSet::fromCards(cards);
+    if (cards.size() <= 7)
+        return HandValue::fromScore(EvaluatorRegistry::active().evaluate(hand));
+
+    return HandValue::fromScore(BitmaskHandEvaluator::evaluate(hand));
+}
+
+EvaluatorMode AdvancedHandEvaluator::mode()
+{
+    // Function-local static: the table is mapped once, thread-safely
+    static const EvaluatorMode selected =
+        LookupTableEvaluator::load(LookupTableEvaluator::defaultPath())
+            ? EvaluatorMode::LookupTable
+            : EvaluatorMode::Algorithmic;
+    return selected;
+}
+
+void AdvancedHandEvaluator::evaluateBatch(const CardSet *hands, uint32_t *out, size_t n)
+{
+    EvaluatorRegistry::active().evaluateBatch(hands, out, n);
+}
+
+/**
+ * Score several hole pairs against one board
+ *
+ * The board is reduced to rank multiplicity masks once (SharedBoard), so
+ * each hole pair costs two rank-bit updates and one evaluateMasks call
+ * instead of a full 7-card evaluation.
+ */
+void AdvancedHandEvaluator::evaluateAgainstBoard(CardSet board, const HolePair *holePairs,
+                                                 uint32_t *out, size_t n)
+{
+    SharedBoard::of(board).score(holePairs, out, n);
+}
+
+void AdvancedHandEvaluator::evaluateAgainstBoard(CardSpan board, const HolePair *holePairs, uint32_t *out, size_t n)
+{
+    evaluateAgainstBoard(CardSet::fromCards(board), holePairs, out, n);
+}
+
+/**
+ * Frequency-map evaluator kept as the readable reference implementation
+ * 
+ * Slow (maps, vectors and sorts on every call) but easy to audit; the
+ * tests and benchmarks check the bitmask evaluator against it.
+ */
+HandValue AdvancedHandEvaluator::evaluateReference(CardSpan cards)
 {
     // Validate input
     if (cards.size() < 5)
@@ -131,9 +200,9 @@ HandValue AdvancedHandEvaluator::evaluate(const std::vector<Card> &cards)
         if (isStraight(suitedRanks, sfHighCard))
         {
             if (sfHighCard == 14) // A-K-Q-J-10
-                return HandValue{HandRank::RoyalFlush, {14}};
+                return makeValue(HandRank::RoyalFlush, {14});
             else
-                return HandValue{HandRank::StraightFlush, {sfHighCard}};
+                return makeValue(HandRank::StraightFlush, {sfHighCard});
         }
     }
 
@@ -141,9 +210,14 @@ HandValue AdvancedHandEvaluator::evaluate(const std::vector<Card> &cards)
     if (!quads.empty())
     {
         // Highest card not in the quads as kicker
-        int kicker = singles.empty() ? (trips.empty() ? 0 : trips[0]) : singles[0];
-        return HandValue{
-            HandRank::FourOfAKind, {quads[0], kicker}};
+        int kicker = 0;
+        if (!singles.empty())
+            kicker = std::max(kicker, singles[0]);
+        if (!pairs.empty())
+            kicker = std::max(kicker, pairs[0]);
+        if (!trips.empty())
+            kicker = std::max(kicker, trips[0]);
+        return makeValue(HandRank::FourOfAKind, {quads[0], kicker});
     }
 
     // Check for Full House (three of a kind + pair)
@@ -151,8 +225,10 @@ HandValue AdvancedHandEvaluator::evaluate(const std::vector<Card> &cards)
     {
         int trip = trips[0];  // Highest three of a kind
         // Either another three of a kind, or highest pair
-        int pair = (trips.size() > 1) ? trips[1] : pairs[0];
-        return HandValue{HandRank::FullHouse, {trip, pair}};
+        int pair = (trips.size() > 1) ? trips[1] : 0;
+        if (!pairs.empty())
+            pair = std::max(pair, pairs[0]);
+        return makeValue(HandRank::FullHouse, {trip, pair});
     }
 
     // Check for Flush
@@ -165,7 +241,7 @@ HandValue AdvancedHandEvaluator::evaluate(const std::vector<Card> &cards)
                 flushRanks.push_back(rankToInt(c.rank));
             std::sort(flushRanks.rbegin(), flushRanks.rend());
             flushRanks.resize(5);  // Keep top 5 cards of the flush
-            return HandValue{HandRank::Flush, flushRanks};
+            return makeValue(HandRank::Flush, flushRanks);
         }
     }
 
@@ -173,7 +249,7 @@ HandValue AdvancedHandEvaluator::evaluate(const std::vector<Card> &cards)
     int straightHigh = 0;
     if (isStraight(allRanks, straightHigh))
     {
-        return HandValue{HandRank::Straight, {straightHigh}};
+        return makeValue(HandRank::Straight, {straightHigh});
     }
 
     // Check for Three of a Kind
@@ -188,14 +264,17 @@ HandValue AdvancedHandEvaluator::evaluate(const std::vector<Card> &cards)
         // Ensure we have at least 2 kickers (even if 0)
         while (kickers.size() < 2)
             kickers.push_back(0);
-        return HandValue{HandRank::ThreeOfAKind, {trips[0], kickers[0], kickers[1]}};
+        return makeValue(HandRank::ThreeOfAKind, {trips[0], kickers[0], kickers[1]});
     }
 
     // Check for Two Pair
     if (pairs.size() >= 2)
     {
+        // A third pair can play as the kicker
         int kicker = singles.empty() ? 0 : singles[0];
-        return HandValue{HandRank::TwoPair, {pairs[0], pairs[1], kicker}};
+        if (pairs.size() > 2)
+            kicker = std::max(kicker, pairs[2]);
+        return makeValue(HandRank::TwoPair, {pairs[0], pairs[1], kicker});
     }
 
     // Check for One Pair
@@ -204,11 +283,11 @@ HandValue AdvancedHandEvaluator::evaluate(const std::vector<Card> &cards)
         std::vector<int> kickers = {pairs[0]};
         for (int i = 0; i < 3 && i < (int)singles.size(); ++i)
             kickers.push_back(singles[i]);
-        return HandValue{HandRank::OnePair, kickers};
+        return makeValue(HandRank::OnePair, kickers);
     }
 
     // High Card (default)
     std::sort(allRanks.rbegin(), allRanks.rend());
     allRanks.resize(5);  // Take top 5 cards
-    return HandValue{HandRank::HighCard, allRanks};
+    return makeValue(HandRank::HighCard, allRanks);
 }
\ No newline at end of file
@@ -2,13 +2,46 @@
 #define ADVANCED_HAND_EVALUATOR_H
 
 #include "card.h"
+#include "card_set.h"
+#include "fixed_hand_evaluator.h"
 #include "hand_types.h"
+#include "shared_board.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
+// Whether the precomputed table is available to EvaluatorRegistry
+enum class EvaluatorMode
+{
+    Algorithmic,
+    LookupTable
+};
+
 class AdvancedHandEvaluator
 {
 public:
-    static HandValue evaluate(const std::vector<Card> &cards);
+    static HandValue evaluate(CardSpan cards);
+
+    // Exactly N = 5, 6 or 7 cards: no size check, no allocation, constexpr
+    template <size_t N>
+    static constexpr HandValue evaluate(const std::array<CardId, N> &cards)
+    {
+        return HandValue::fromScore(FixedHandEvaluator::evaluate(cards));
+    }
+
+    // Maps the precomputed table on first use; Algorithmic if it is missing or
+    // stale. evaluate() uses the table only when the registry selects it
+    // (POKER_EVALUATOR=table).
+    static EvaluatorMode mode();
+
+    // Packed HandValue scores for n hands through EvaluatorRegistry::active()
+    static void evaluateBatch(const CardSet *hands, uint32_t *out, size_t n);
+
+    // Packed scores of n hole pairs, each combined with the same board
+    static void evaluateAgainstBoard(CardSet board, const HolePair *holePairs, uint32_t *out, size_t n);
+    static void evaluateAgainstBoard(CardSpan board, const HolePair *holePairs, uint32_t *out, size_t n);
+    static HandValue evaluateReference(CardSpan cards);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,461 @@
+// batch_hand_evaluator.cpp
+#include "batch_hand_evaluator.h"
+#include "bitmask_hand_evaluator.h"
+#include "rank_tables.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define BATCH_EVAL_X86 1
+#endif
+
+// Per-rank-mask facts (top kickers, straight, popcount); one gather per question
+static const uint32_t *maskInfo()
+{
+    return RANK_TABLES.info;
+}
+
+void BatchHandEvaluator::evaluateScalar(const CardSet *hands, uint32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+        out[i] = BitmaskHandEvaluator::evaluate(hands[i]);
+}
+
+#ifdef BATCH_EVAL_X86
+
+bool BatchHandEvaluator::avx2Supported()
+{
+    return __builtin_cpu_supports("avx2");
+}
+
+bool BatchHandEvaluator::avx512Supported()
+{
+    return __builtin_cpu_supports("avx512f");
+}
+
+bool BatchHandEvaluator::bmi2Supported()
+{
+    return __builtin_cpu_supports("bmi2") && __builtin_cpu_supports("popcnt");
+}
+
+// ---------------------------------------------------------------- AVX2
+
+#define AVX2_TARGET __attribute__((target("avx2")))
+
+AVX2_TARGET static inline __m256i lookup8(const uint32_t *info, __m256i masks)
+{
+    return _mm256_i32gather_epi32(reinterpret_cast<const int *>(info), masks, 4);
+}
+
+AVX2_TARGET static inline __m256i field8(__m256i v, int shift)
+{
+    return _mm256_and_si256(_mm256_srli_epi32(v, shift), _mm256_set1_epi32(0xF));
+}
+
+// Highest rank (2-14) present in each mask, 0 for an empty mask
+AVX2_TARGET static inline __m256i top8(const uint32_t *info, __m256i masks)
+{
+    return field8(lookup8(info, masks), 16);
+}
+
+// Rank value -> its bit in a rank mask; 0 maps to no bit
+AVX2_TARGET static inline __m256i rankBit8(__m256i rank)
+{
+    return _mm256_sllv_epi32(_mm256_set1_epi32(1), _mm256_sub_epi32(rank, _mm256_set1_epi32(2)));
+}
+
+AVX2_TARGET static inline __m256i nonZero8(__m256i v)
+{
+    return _mm256_xor_si256(_mm256_cmpeq_epi32(v, _mm256_setzero_si256()), _mm256_set1_epi32(-1));
+}
+
+AVX2_TARGET static inline __m256i category8(HandRank rank)
+{
+    return _mm256_set1_epi32(static_cast<int>(rank) << HandValue::CATEGORY_SHIFT);
+}
+
+// Keep the suit mask only where it holds five or more cards
+AVX2_TARGET static inline __m256i flushSuit8(const uint32_t *info, __m256i suit)
+{
+    __m256i count = field8(lookup8(info, suit), 24);
+    return _mm256_and_si256(suit, _mm256_cmpgt_epi32(count, _mm256_set1_epi32(4)));
+}
+
+AVX2_TARGET void BatchHandEvaluator::evaluateAvx2(const CardSet *hands, uint32_t *out, size_t n)
+{
+    const uint32_t *info = maskInfo();
+    const __m256i lanes = _mm256_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14);
+    const __m256i rankMask = _mm256_set1_epi32(0x1FFF);
+    const __m256i low20 = _mm256_set1_epi32(0xFFFFF);
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        // Each CardSet is two 32-bit words: suits 0|1 and suits 2|3
+        const int *base = reinterpret_cast<const int *>(hands + i);
+        __m256i lo = _mm256_i32gather_epi32(base, lanes, 4);
+        __m256i hi = _mm256_i32gather_epi32(base + 1, lanes, 4);
+        __m256i c = _mm256_and_si256(lo, rankMask);
+        __m256i d = _mm256_and_si256(_mm256_srli_epi32(lo, 16), rankMask);
+        __m256i h = _mm256_and_si256(hi, rankMask);
+        __m256i s = _mm256_and_si256(_mm256_srli_epi32(hi, 16), rankMask);
+
+        __m256i flush = _mm256_or_si256(_mm256_or_si256(flushSuit8(info, c), flushSuit8(info, d)),
+                                        _mm256_or_si256(flushSuit8(info, h), flushSuit8(info, s)));
+
+        __m256i cd = _mm256_and_si256(c, d), hs = _mm256_and_si256(h, s);
+        __m256i cOrD = _mm256_or_si256(c, d), hOrS = _mm256_or_si256(h, s);
+        __m256i atLeast1 = _mm256_or_si256(cOrD, hOrS);
+        __m256i atLeast2 = _mm256_or_si256(_mm256_or_si256(cd, hs), _mm256_and_si256(cOrD, hOrS));
+        __m256i atLeast3 = _mm256_or_si256(_mm256_and_si256(cd, hOrS), _mm256_and_si256(hs, cOrD));
+        __m256i atLeast4 = _mm256_and_si256(cd, hs);
+
+        __m256i flushInfo = lookup8(info, flush);
+        __m256i rankInfo = lookup8(info, atLeast1);
+        __m256i pairInfo = lookup8(info, atLeast2);
+
+        // Categories from weakest to strongest; each applicable one overwrites
+        __m256i result = _mm256_and_si256(rankInfo, low20);
+
+        __m256i pair = field8(pairInfo, 16);
+        __m256i pairKickers = lookup8(info, _mm256_andnot_si256(rankBit8(pair), atLeast1));
+        __m256i onePair = _mm256_or_si256(
+            _mm256_or_si256(category8(HandRank::OnePair), _mm256_slli_epi32(pair, 16)),
+            _mm256_and_si256(_mm256_srli_epi32(pairKickers, 4), _mm256_set1_epi32(0xFFF0)));
+        result = _mm256_blendv_epi8(result, onePair, nonZero8(atLeast2));
+
+        __m256i lowPair = field8(pairInfo, 12);
+        __m256i twoPairKicker = top8(info, _mm256_andnot_si256(
+                                               _mm256_or_si256(rankBit8(pair), rankBit8(lowPair)), atLeast1));
+        __m256i twoPair = _mm256_or_si256(
+            _mm256_or_si256(category8(HandRank::TwoPair), _mm256_slli_epi32(pair, 16)),
+            _mm256_or_si256(_mm256_slli_epi32(lowPair, 12), _mm256_slli_epi32(twoPairKicker, 8)));
+        result = _mm256_blendv_epi8(result, twoPair, nonZero8(lowPair));
+
+        __m256i trip = top8(info, atLeast3);
+        __m256i tripKickers = lookup8(info, _mm256_andnot_si256(rankBit8(trip), atLeast1));
+        __m256i trips = _mm256_or_si256(
+            _mm256_or_si256(category8(HandRank::ThreeOfAKind), _mm256_slli_epi32(trip, 16)),
+            _mm256_and_si256(_mm256_srli_epi32(tripKickers, 4), _mm256_set1_epi32(0xFF00)));
+        result = _mm256_blendv_epi8(result, trips, nonZero8(atLeast3));
+
+        __m256i straightHigh = field8(rankInfo, 20);
+        __m256i straight = _mm256_or_si256(category8(HandRank::Straight), _mm256_slli_epi32(straightHigh, 16));
+        result = _mm256_blendv_epi8(result, straight, nonZero8(straightHigh));
+
+        __m256i flushScore = _mm256_or_si256(category8(HandRank::Flush), _mm256_and_si256(flushInfo, low20));
+        result = _mm256_blendv_epi8(result, flushScore, nonZero8(flush));
+
+        __m256i fullPair = top8(info, _mm256_andnot_si256(rankBit8(trip), atLeast2));
+        __m256i fullHouse = _mm256_or_si256(
+            _mm256_or_si256(category8(HandRank::FullHouse), _mm256_slli_epi32(trip, 16)),
+            _mm256_slli_epi32(fullPair, 12));
+        result = _mm256_blendv_epi8(result, fullHouse, _mm256_and_si256(nonZero8(atLeast3), nonZero8(fullPair)));
+
+        __m256i quad = top8(info, atLeast4);
+        __m256i quadKicker = top8(info, _mm256_andnot_si256(rankBit8(quad), atLeast1));
+        __m256i quads = _mm256_or_si256(
+            _mm256_or_si256(category8(HandRank::FourOfAKind), _mm256_slli_epi32(quad, 16)),
+            _mm256_slli_epi32(quadKicker, 12));
+        result = _mm256_blendv_epi8(result, quads, nonZero8(atLeast4));
+
+        // Royal flush is the straight flush whose high card is the Ace
+        __m256i sfHigh = field8(flushInfo, 20);
+        __m256i isRoyal = _mm256_cmpeq_epi32(sfHigh, _mm256_set1_epi32(14));
+        __m256i sfCategory = _mm256_blendv_epi8(category8(HandRank::StraightFlush),
+                                                category8(HandRank::RoyalFlush), isRoyal);
+        __m256i straightFlush = _mm256_or_si256(sfCategory, _mm256_slli_epi32(sfHigh, 16));
+        result = _mm256_blendv_epi8(result, straightFlush, nonZero8(sfHigh));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), result);
+    }
+
+    evaluateScalar(hands + i, out + i, n - i);
+}
+
+// ---------------------------------------------------------------- BMI2
+
+#define BMI2_TARGET __attribute__((target("bmi,bmi2,lzcnt,popcnt")))
+
+/**
+ * The `count` highest ranks of a mask as nibbles, most significant first
+ *
+ * pdep deposits a run of ones into the set bits of `ranks`, selecting its
+ * top `count` ranks without a loop; tzcnt/blsr then walk them upwards.
+ */
+BMI2_TARGET static inline uint32_t topNibbles(uint32_t ranks, int count)
+{
+    int held = static_cast<int>(_mm_popcnt_u32(ranks));
+    if (held > count)
+    {
+        ranks = _pdep_u32(~0u << (held - count), ranks);
+        held = count;
+    }
+
+    uint32_t nibbles = 0;
+    for (int shift = 4 * (count - held); ranks; shift += 4)
+    {
+        nibbles |= (_tzcnt_u32(ranks) + 2) << shift;
+        ranks = _blsr_u32(ranks);
+    }
+    return nibbles;
+}
+
+BMI2_TARGET static inline uint32_t highRank(uint32_t ranks)
+{
+    return 33 - _lzcnt_u32(ranks); // 31 - lzcnt is the bit, +2 the rank
+}
+
+BMI2_TARGET static inline uint32_t packBmi2(HandRank rank, uint32_t kickers, int count)
+{
+    return (static_cast<uint32_t>(rank) << HandValue::CATEGORY_SHIFT) | (kickers << (4 * (5 - count)));
+}
+
+BMI2_TARGET uint32_t BatchHandEvaluator::evaluateBmi2(CardSet cards)
+{
+    // pext gathers each suit's 13 rank bits out of its 16-bit lane
+    const uint32_t c = static_cast<uint32_t>(_pext_u64(cards.bits, CardSet::RANK_MASK));
+    const uint32_t d = static_cast<uint32_t>(_pext_u64(cards.bits, CardSet::RANK_MASK << 16));
+    const uint32_t h = static_cast<uint32_t>(_pext_u64(cards.bits, CardSet::RANK_MASK << 32));
+    const uint32_t s = static_cast<uint32_t>(_pext_u64(cards.bits, CardSet::RANK_MASK << 48));
+
+    uint32_t flush = 0;
+    for (uint32_t suit : {c, d, h, s})
+        if (_mm_popcnt_u32(suit) >= 5)
+            flush = suit;
+
+    const uint32_t atLeast1 = c | d | h | s;
+    const uint32_t atLeast2 = (c & d) | (h & s) | ((c | d) & (h | s));
+    const uint32_t atLeast3 = (c & d & (h | s)) | (h & s & (c | d));
+    const uint32_t atLeast4 = c & d & h & s;
+
+    if (flush)
+    {
+        uint32_t sfHigh = straightHighOf(flush);
+        if (sfHigh == 14)
+            return packBmi2(HandRank::RoyalFlush, 14, 1);
+        if (sfHigh)
+            return packBmi2(HandRank::StraightFlush, sfHigh, 1);
+    }
+
+    if (atLeast4)
+    {
+        uint32_t quad = highRank(atLeast4);
+        return packBmi2(HandRank::FourOfAKind, (quad << 4) | topNibbles(atLeast1 & ~rankBit(quad), 1), 2);
+    }
+
+    uint32_t trip = atLeast3 ? highRank(atLeast3) : 0;
+    if (trip)
+    {
+        uint32_t pairs = atLeast2 & ~rankBit(trip);
+        if (pairs)
+            return packBmi2(HandRank::FullHouse, (trip << 4) | highRank(pairs), 2);
+    }
+
+    if (flush)
+        return packBmi2(HandRank::Flush, topNibbles(flush, 5), 5);
+
+    if (uint32_t high = straightHighOf(atLeast1))
+        return packBmi2(HandRank::Straight, high, 1);
+
+    if (trip)
+        return packBmi2(HandRank::ThreeOfAKind, (trip << 8) | topNibbles(atLeast1 & ~rankBit(trip), 2), 3);
+
+    if (atLeast2)
+    {
+        uint32_t high = highRank(atLeast2);
+        uint32_t rest = atLeast2 & ~rankBit(high);
+        if (rest)
+        {
+            uint32_t low = highRank(rest);
+            uint32_t kicker = topNibbles(atLeast1 & ~rankBit(high) & ~rankBit(low), 1);
+            return packBmi2(HandRank::TwoPair, (high << 8) | (low << 4) | kicker, 3);
+        }
+        return packBmi2(HandRank::OnePair, (high << 12) | topNibbles(atLeast1 & ~rankBit(high), 3), 4);
+    }
+
+    return packBmi2(HandRank::HighCard, topNibbles(atLeast1, 5), 5);
+}
+
+BMI2_TARGET void BatchHandEvaluator::evaluateBmi2(const CardSet *hands, uint32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+        out[i] = evaluateBmi2(hands[i]);
+}
+
+// ------------------------------------------------------------- AVX-512
+
+// GCC 12 reports its own _mm512_undefined_* placeholders as uninitialized
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+#define AVX512_TARGET __attribute__((target("avx512f")))
+
+AVX512_TARGET static inline __m512i lookup16(const uint32_t *info, __m512i masks)
+{
+    return _mm512_i32gather_epi32(masks, reinterpret_cast<const int *>(info), 4);
+}
+
+AVX512_TARGET static inline __m512i field16(__m512i v, int shift)
+{
+    return _mm512_and_si512(_mm512_srli_epi32(v, shift), _mm512_set1_epi32(0xF));
+}
+
+AVX512_TARGET static inline __m512i top16(const uint32_t *info, __m512i masks)
+{
+    return field16(lookup16(info, masks), 16);
+}
+
+AVX512_TARGET static inline __m512i rankBit16(__m512i rank)
+{
+    return _mm512_sllv_epi32(_mm512_set1_epi32(1), _mm512_sub_epi32(rank, _mm512_set1_epi32(2)));
+}
+
+AVX512_TARGET static inline __mmask16 nonZero16(__m512i v)
+{
+    return _mm512_test_epi32_mask(v, v);
+}
+
+AVX512_TARGET static inline __m512i category16(HandRank rank)
+{
+    return _mm512_set1_epi32(static_cast<int>(rank) << HandValue::CATEGORY_SHIFT);
+}
+
+AVX512_TARGET static inline __m512i flushSuit16(const uint32_t *info, __m512i suit)
+{
+    __m512i count = field16(lookup16(info, suit), 24);
+    return _mm512_maskz_mov_epi32(_mm512_cmpgt_epi32_mask(count, _mm512_set1_epi32(4)), suit);
+}
+
+AVX512_TARGET void BatchHandEvaluator::evaluateAvx512(const CardSet *hands, uint32_t *out, size_t n)
+{
+    const uint32_t *info = maskInfo();
+    const __m512i lanes = _mm512_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30);
+    const __m512i rankMask = _mm512_set1_epi32(0x1FFF);
+    const __m512i low20 = _mm512_set1_epi32(0xFFFFF);
+
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        const int *base = reinterpret_cast<const int *>(hands + i);
+        __m512i lo = _mm512_i32gather_epi32(lanes, base, 4);
+        __m512i hi = _mm512_i32gather_epi32(lanes, base + 1, 4);
+        __m512i c = _mm512_and_si512(lo, rankMask);
+        __m512i d = _mm512_and_si512(_mm512_srli_epi32(lo, 16), rankMask);
+        __m512i h = _mm512_and_si512(hi, rankMask);
+        __m512i s = _mm512_and_si512(_mm512_srli_epi32(hi, 16), rankMask);
+
+        __m512i flush = _mm512_or_si512(_mm512_or_si512(flushSuit16(info, c), flushSuit16(info, d)),
+                                        _mm512_or_si512(flushSuit16(info, h), flushSuit16(info, s)));
+
+        __m512i cd = _mm512_and_si512(c, d), hs = _mm512_and_si512(h, s);
+        __m512i cOrD = _mm512_or_si512(c, d), hOrS = _mm512_or_si512(h, s);
+        __m512i atLeast1 = _mm512_or_si512(cOrD, hOrS);
+        __m512i atLeast2 = _mm512_or_si512(_mm512_or_si512(cd, hs), _mm512_and_si512(cOrD, hOrS));
+        __m512i atLeast3 = _mm512_or_si512(_mm512_and_si512(cd, hOrS), _mm512_and_si512(hs, cOrD));
+        __m512i atLeast4 = _mm512_and_si512(cd, hs);
+
+        __m512i flushInfo = lookup16(info, flush);
+        __m512i rankInfo = lookup16(info, atLeast1);
+        __m512i pairInfo = lookup16(info, atLeast2);
+
+        __m512i result = _mm512_and_si512(rankInfo, low20);
+
+        __m512i pair = field16(pairInfo, 16);
+        __m512i pairKickers = lookup16(info, _mm512_andnot_si512(rankBit16(pair), atLeast1));
+        __m512i onePair = _mm512_or_si512(
+            _mm512_or_si512(category16(HandRank::OnePair), _mm512_slli_epi32(pair, 16)),
+            _mm512_and_si512(_mm512_srli_epi32(pairKickers, 4), _mm512_set1_epi32(0xFFF0)));
+        result = _mm512_mask_blend_epi32(nonZero16(atLeast2), result, onePair);
+
+        __m512i lowPair = field16(pairInfo, 12);
+        __m512i twoPairKicker = top16(info, _mm512_andnot_si512(
+                                                _mm512_or_si512(rankBit16(pair), rankBit16(lowPair)), atLeast1));
+        __m512i twoPair = _mm512_or_si512(
+            _mm512_or_si512(category16(HandRank::TwoPair), _mm512_slli_epi32(pair, 16)),
+            _mm512_or_si512(_mm512_slli_epi32(lowPair, 12), _mm512_slli_epi32(twoPairKicker, 8)));
+        result = _mm512_mask_blend_epi32(nonZero16(lowPair), result, twoPair);
+
+        __m512i trip = top16(info, atLeast3);
+        __m512i tripKickers = lookup16(info, _mm512_andnot_si512(rankBit16(trip), atLeast1));
+        __m512i trips = _mm512_or_si512(
+            _mm512_or_si512(category16(HandRank::ThreeOfAKind), _mm512_slli_epi32(trip, 16)),
+            _mm512_and_si512(_mm512_srli_epi32(tripKickers, 4), _mm512_set1_epi32(0xFF00)));
+        result = _mm512_mask_blend_epi32(nonZero16(atLeast3), result, trips);
+
+        __m512i straightHigh = field16(rankInfo, 20);
+        __m512i straight = _mm512_or_si512(category16(HandRank::Straight), _mm512_slli_epi32(straightHigh, 16));
+        result = _mm512_mask_blend_epi32(nonZero16(straightHigh), result, straight);
+
+        __m512i flushScore = _mm512_or_si512(category16(HandRank::Flush), _mm512_and_si512(flushInfo, low20));
+        result = _mm512_mask_blend_epi32(nonZero16(flush), result, flushScore);
+
+        __m512i fullPair = top16(info, _mm512_andnot_si512(rankBit16(trip), atLeast2));
+        __m512i fullHouse = _mm512_or_si512(
+            _mm512_or_si512(category16(HandRank::FullHouse), _mm512_slli_epi32(trip, 16)),
+            _mm512_slli_epi32(fullPair, 12));
+        result = _mm512_mask_blend_epi32(nonZero16(atLeast3) & nonZero16(fullPair), result, fullHouse);
+
+        __m512i quad = top16(info, atLeast4);
+        __m512i quadKicker = top16(info, _mm512_andnot_si512(rankBit16(quad), atLeast1));
+        __m512i quads = _mm512_or_si512(
+            _mm512_or_si512(category16(HandRank::FourOfAKind), _mm512_slli_epi32(quad, 16)),
+            _mm512_slli_epi32(quadKicker, 12));
+        result = _mm512_mask_blend_epi32(nonZero16(atLeast4), result, quads);
+
+        __m512i sfHigh = field16(flushInfo, 20);
+        __mmask16 isRoyal = _mm512_cmpeq_epi32_mask(sfHigh, _mm512_set1_epi32(14));
+        __m512i sfCategory = _mm512_mask_blend_epi32(isRoyal, category16(HandRank::StraightFlush),
+                                                     category16(HandRank::RoyalFlush));
+        __m512i straightFlush = _mm512_or_si512(sfCategory, _mm512_slli_epi32(sfHigh, 16));
+        result = _mm512_mask_blend_epi32(nonZero16(sfHigh), result, straightFlush);
+
+        _mm512_storeu_si512(out + i, result);
+    }
+
+    evaluateScalar(hands + i, out + i, n - i);
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+#else // !BATCH_EVAL_X86
+
+bool BatchHandEvaluator::bmi2Supported()
+{
+    return false;
+}
+
+bool BatchHandEvaluator::avx2Supported()
+{
+    return false;
+}
+
+bool BatchHandEvaluator::avx512Supported()
+{
+    return false;
+}
+
+uint32_t BatchHandEvaluator::evaluateBmi2(CardSet cards)
+{
+    return BitmaskHandEvaluator::evaluate(cards);
+}
+
+void BatchHandEvaluator::evaluateBmi2(const CardSet *hands, uint32_t *out, size_t n)
+{
+    evaluateScalar(hands, out, n);
+}
+
+void BatchHandEvaluator::evaluateAvx2(const CardSet *hands, uint32_t *out, size_t n)
+{
+    evaluateScalar(hands, out, n);
+}
+
+void BatchHandEvaluator::evaluateAvx512(const CardSet *hands, uint32_t *out, size_t n)
+{
+    evaluateScalar(hands, out, n);
+}
+
+#endif // BATCH_EVAL_X86
@@ -0,0 +1,36 @@
+#ifndef BATCH_HAND_EVALUATOR_H
+#define BATCH_HAND_EVALUATOR_H
+
+#include "card_set.h"
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * CPU-specific kernels behind the evaluator registry
+ *
+ * The BMI2 kernel is the scalar algorithm using pext to split the suits,
+ * pdep to select top kickers and lzcnt/tzcnt/popcnt instructions.
+ *
+ * The vector kernels evaluate 8 (AVX2) or 16 (AVX-512) hands per iteration
+ * without data-dependent branches: every lane computes each category's
+ * candidate score from a per-rank-mask info table and the best applicable
+ * one is kept with blends. All kernels write the same packed HandValue
+ * scores as BitmaskHandEvaluator::evaluate.
+ */
+class BatchHandEvaluator
+{
+public:
+    static bool bmi2Supported();
+    static bool avx2Supported();
+    static bool avx512Supported();
+
+    static void evaluateScalar(const CardSet *hands, uint32_t *out, size_t n);
+
+    // Only call when the matching *Supported() returns true
+    static uint32_t evaluateBmi2(CardSet cards);
+    static void evaluateBmi2(const CardSet *hands, uint32_t *out, size_t n);
+    static void evaluateAvx2(const CardSet *hands, uint32_t *out, size_t n);
+    static void evaluateAvx512(const CardSet *hands, uint32_t *out, size_t n);
+};
+
+#endif // BATCH_HAND_EVALUATOR_H
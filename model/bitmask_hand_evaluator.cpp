@@ -0,0 +1,134 @@
+// bitmask_hand_evaluator.cpp
+#include "bitmask_hand_evaluator.h"
+
+/**
+ * Highest set bit of a non-zero mask
+ */
+static inline int highBit(uint32_t mask)
+{
+    return 31 - __builtin_clz(mask);
+}
+
+/**
+ * High card of the best straight in a 13-bit rank mask, 0 if there is none
+ *
+ * The mask is shifted up by one so the Ace can also sit below the Two;
+ * a bit that survives four shifted ANDs closes a run of five ranks.
+ */
+static inline int straightHigh(uint32_t ranks)
+{
+    uint32_t m = (ranks << 1) | ((ranks >> 12) & 1);
+    uint32_t runs = m & (m << 1) & (m << 2) & (m << 3) & (m << 4);
+    return runs ? highBit(runs) + 1 : 0;
+}
+
+/**
+ * Append the `count` highest ranks of `ranks` to a score, one nibble each
+ */
+static inline uint32_t appendTop(uint32_t score, uint32_t ranks, int count)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        uint32_t nibble = 0;
+        if (ranks)
+        {
+            int r = highBit(ranks);
+            nibble = r + 2;
+            ranks &= ~(1u << r);
+        }
+        score = (score << 4) | nibble;
+    }
+    return score;
+}
+
+/**
+ * Left-align the kicker nibbles and put the category on top
+ */
+static inline uint32_t pack(HandRank rank, uint32_t kickers, int count)
+{
+    return (static_cast<uint32_t>(rank) << HandValue::CATEGORY_SHIFT) |
+           (kickers << (4 * (5 - count)));
+}
+
+uint32_t BitmaskHandEvaluator::evaluate(CardSet cards)
+{
+    const uint32_t c = cards.suitMask(0);
+    const uint32_t d = cards.suitMask(1);
+    const uint32_t h = cards.suitMask(2);
+    const uint32_t s = cards.suitMask(3);
+
+    // At most one suit can hold five of seven cards
+    uint32_t flush = 0;
+    if (__builtin_popcount(c) >= 5)
+        flush = c;
+    else if (__builtin_popcount(d) >= 5)
+        flush = d;
+    else if (__builtin_popcount(h) >= 5)
+        flush = h;
+    else if (__builtin_popcount(s) >= 5)
+        flush = s;
+
+    // Rank multiplicities: bit r of atLeastN is set when rank r appears N+ times
+    return evaluateMasks(c | d | h | s,
+                         (c & d) | (h & s) | ((c | d) & (h | s)),
+                         (c & d & (h | s)) | (h & s & (c | d)),
+                         c & d & h & s,
+                         flush);
+}
+
+uint32_t BitmaskHandEvaluator::evaluateMasks(uint32_t atLeast1, uint32_t atLeast2,
+                                             uint32_t atLeast3, uint32_t atLeast4,
+                                             uint32_t flush)
+{
+    if (flush)
+    {
+        int sfHigh = straightHigh(flush);
+        if (sfHigh == 14)
+            return pack(HandRank::RoyalFlush, 14, 1);
+        if (sfHigh)
+            return pack(HandRank::StraightFlush, sfHigh, 1);
+    }
+
+    if (atLeast4)
+    {
+        int quad = highBit(atLeast4);
+        uint32_t score = appendTop(quad + 2, atLeast1 & ~(1u << quad), 1);
+        return pack(HandRank::FourOfAKind, score, 2);
+    }
+
+    if (atLeast3)
+    {
+        int trip = highBit(atLeast3);
+        uint32_t pairs = atLeast2 & ~(1u << trip);
+        if (pairs)
+            return pack(HandRank::FullHouse, appendTop(trip + 2, pairs, 1), 2);
+    }
+
+    if (flush)
+        return pack(HandRank::Flush, appendTop(0, flush, 5), 5);
+
+    if (int high = straightHigh(atLeast1))
+        return pack(HandRank::Straight, high, 1);
+
+    if (atLeast3)
+    {
+        int trip = highBit(atLeast3);
+        return pack(HandRank::ThreeOfAKind, appendTop(trip + 2, atLeast1 & ~(1u << trip), 2), 3);
+    }
+
+    if (atLeast2)
+    {
+        int high = highBit(atLeast2);
+        uint32_t rest = atLeast2 & ~(1u << high);
+        if (rest)
+        {
+            int low = highBit(rest);
+            uint32_t kickers = atLeast1 & ~(1u << high) & ~(1u << low);
+            uint32_t score = ((high + 2) << 4) | (low + 2);
+            return pack(HandRank::TwoPair, appendTop(score, kickers, 1), 3);
+        }
+        return pack(HandRank::OnePair, appendTop(high + 2, atLeast1 & ~(1u << high), 3), 4);
+    }
+
+    return pack(HandRank::HighCard, appendTop(0, atLeast1, 5), 5);
+}
@@ -0,0 +1,30 @@
+#ifndef BITMASK_HAND_EVALUATOR_H
+#define BITMASK_HAND_EVALUATOR_H
+
+#include "card_set.h"
+#include "hand_types.h"
+#include <cstdint>
+
+/**
+ * Allocation-free 5 to 7 card evaluator working on per-suit rank masks
+ *
+ * The result is the packed HandValue score, so comparing two results as
+ * integers orders the hands; HandValue::fromScore gives the full view.
+ */
+class BitmaskHandEvaluator
+{
+public:
+    static uint32_t evaluate(CardSet cards);
+
+    /**
+     * Score a hand already reduced to rank multiplicity masks
+     *
+     * Bit r of atLeastN is set when rank r + 2 appears at least N times;
+     * `flush` holds the ranks of a suit with five or more cards, or 0.
+     */
+    static uint32_t evaluateMasks(uint32_t atLeast1, uint32_t atLeast2,
+                                  uint32_t atLeast3, uint32_t atLeast4,
+                                  uint32_t flush);
+};
+
+#endif // BITMASK_HAND_EVALUATOR_H
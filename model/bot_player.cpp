@@ -1,28 +1,51 @@
 #include "bot_player.h"
 #include "advanced_hand_evaluator.h"
+#include "deck.h"
+#include "evaluator_registry.h"
 #include "poker_math.h"
+#include "rank_tables.h"
 #include "../view/bot_thinking_visualizer.h"
 #include "../utils/performance_monitor.h"
+#include "../utils/work_stealing_pool.h"
 #include <cstdlib>
-#include <future>
 #include <random>
 #include <algorithm>
 #include <chrono>
-#include <map>
+#include <cstdio>
+#include <array>
+#include <functional>
 #include <iostream>
+#include <stdexcept>
+
+namespace {
+// Built once: a literal would construct a fresh std::string on every call
+const std::string SIMULATION_TIMER = "MonteCarlo_Simulation";
+}
 
 BotPlayer::BotPlayer(const std::string &name, int chips, BotDifficulty diff)
-    : Player(name, chips), difficulty(diff), rng(std::random_device{}()) {
-    // RNG is seeded with random_device for non-deterministic behavior
-    // For testing, can be modified to accept a seed parameter
+    : Player(name, chips), difficulty(diff), rng(Rng::nextStream()) {
+    // Each bot draws from its own stream; set POKER_SEED to replay a game
 }
 
 BotDifficulty BotPlayer::getDifficulty() const {
     return difficulty;
 }
 
-bool BotPlayer::shouldCallBet(const std::vector<Card>& fullHand, GameStage stage) {
-    HandValue eval = AdvancedHandEvaluator::evaluate(fullHand);
+bool BotPlayer::shouldCallBet(CardSpan fullHand, GameStage stage) {
+    if (fullHand.size() < 5) {
+        throw std::invalid_argument("At least 5 cards are required for hand evaluation");
+    }
+
+    // Later streets only add cards: keep the earlier evaluation and fold in
+    // the new ones; a hand that is not a superset starts a fresh state
+    if (!handState.cards().without(CardSet::fromCards(fullHand)).empty()) {
+        handState = EvalState();
+    }
+    for (const Card& c : fullHand) {
+        if (!handState.contains(toCardId(c)))
+            handState.add(c);
+    }
+    HandValue eval = handState.value();
 
     // Show bot thinking header
     std::string diffStr;
@@ -90,14 +113,14 @@ bool BotPlayer::shouldCallEasy() const {
     std::uniform_int_distribution<int> dist(0, 3);
     bool willCall = (dist(rng) == 0);  // 25% chance (1 in 4)
     
-    std::string reasoning = "Random decision (25% chance to call)";
+    const char *reasoning = "Random decision (25% chance to call)";
     BotThinkingVisualizer::showFinalDecision(willCall, reasoning);
     
     return willCall;
 }
 
-bool BotPlayer::shouldCallMedium(const HandValue& eval, GameStage stage, const std::vector<Card>& fullHand) const {
-    std::string reasoning;
+bool BotPlayer::shouldCallMedium(const HandValue& eval, GameStage stage, CardSpan fullHand) const {
+    const char *reasoning = "";
     bool decision = false;
     
     // Base decision on hand strength and game stage
@@ -122,12 +145,10 @@ bool BotPlayer::shouldCallMedium(const HandValue& eval, GameStage stage, const s
     if (stage != GameStage::River && (hasFlush || hasStraight)) {
         BotThinkingVisualizer::showDrawingHandAnalysis(hasFlush, hasStraight, fullHand);
         
-        std::random_device rd;
-        std::mt19937 gen(rd());
         std::uniform_int_distribution<> dis(1, 100);
         
         // 60% chance to call with a drawing hand
-        decision = dis(gen) <= 60;
+        decision = dis(rng) <= 60;
         reasoning = decision ? "Drawing hand detected - Calling (60% chance)" : 
                               "Drawing hand but folding (40% chance)";
         BotThinkingVisualizer::showFinalDecision(decision, reasoning);
@@ -149,8 +170,8 @@ bool BotPlayer::shouldCallMedium(const HandValue& eval, GameStage stage, const s
     return decision;
 }
 
-bool BotPlayer::shouldCallHard(const HandValue& eval, GameStage stage, const std::vector<Card>& fullHand) const {
-    std::string reasoning;
+bool BotPlayer::shouldCallHard(const HandValue& eval, GameStage stage, CardSpan fullHand) const {
+    const char *reasoning = "";
     bool decision = false;
     
     // More sophisticated strategy for Hard bot
@@ -198,60 +219,91 @@ bool BotPlayer::shouldCallHard(const HandValue& eval, GameStage stage, const std
     return decision;
 }
 
-bool BotPlayer::shouldCallHardPlus(const std::vector<Card>& fullHand) {
+bool BotPlayer::shouldCallHardPlus(CardSpan fullHand) {
     // For HardPlus, we'll use Monte Carlo simulation
     
     // Start performance monitoring
-    PerformanceMonitor::start("MonteCarlo_Simulation");
-    
-    const int simulations = 200;
-    const int threads = 4;
-    const int simsPerThread = simulations / threads;
-    std::vector<std::future<std::pair<int, int>>> futures;
+    PerformanceMonitor::start(SIMULATION_TIMER);
+    
+    // Showdowns on the current board against a random opponent hand, in
+    // rounds of 128, 256, 512, ... trials until the win rate is known to
+    // within 6% or is clearly above or below the 40% calling line. Each
+    // look spends half the error rate left, so the stopped interval still
+    // holds at 95%. Easy spots stop after the first round, and on random
+    // spots the average is under the 200 trials this used to run always
+    constexpr int CHUNK = 64;
+    constexpr int FIRST_ROUND_CHUNKS = 2;
+    constexpr int MAX_CHUNKS = 16;  // 1024 trials
+    constexpr double CALL_THRESHOLD = 0.4;
+    constexpr double HALF_WIDTH = 0.06;
+    constexpr double CONFIDENCE = 0.95;
+    std::array<std::pair<int, int>, MAX_CHUNKS> results;
+    std::array<Rng, MAX_CHUNKS> streams;
 
-    // Show Monte Carlo simulation header
-    BotThinkingVisualizer::showMonteCarloHeader(simulations);
+    // Our hand was scored by shouldCallBet; each chunk deals its opponent
+    // hands against the shared board and scores them in one batch. Chunk c
+    // deals from jump-ahead stream c of one draw of our stream, so
+    // POKER_SEED replays the run
+    const uint32_t botScore = handState.score();
+    const CardSet board = CardSet::fromCards(fullHand.from(2));
+    const EvaluatorBackend& evaluator = EvaluatorRegistry::active();
+    Rng master(rng());
+    int first = 0;
 
-    auto simulate = [&]() -> std::pair<int, int> {
-        int wins = 0;
-        int ties = 0;
-        for (int i = 0; i < simsPerThread; ++i) {
-            std::vector<Card> deck;
-            for (int r = 2; r <= 14; ++r) {
-                for (int s = 0; s < 4; ++s) {
-                    Card c(static_cast<Rank>(r), static_cast<Suit>(s));
-                    if (std::find(fullHand.begin(), fullHand.end(), c) == fullHand.end())
-                        deck.push_back(c);
-                }
-            }
-            std::shuffle(deck.begin(), deck.end(), std::mt19937(std::random_device()()));
+    auto simulate = [&](size_t index, unsigned /* worker */) {
+        const int chunk = first + static_cast<int>(index);
 
-            std::vector<Card> opponentHand = { deck[0], deck[1] };
-            std::vector<Card> opponentFullHand = opponentHand;
-            opponentFullHand.insert(opponentFullHand.end(), fullHand.begin() + 2, fullHand.end());
+        // The opponent can hold any card we do not see
+        Deck deck(GameVariant::Holdem, handState.cards(), streams[chunk]);
 
-            HandValue opponentEval = AdvancedHandEvaluator::evaluate(opponentFullHand);
-            HandValue botEval = AdvancedHandEvaluator::evaluate(fullHand);
+        std::array<CardSet, CHUNK> opponentHands;
+        for (CardSet& hand : opponentHands) {
+            deck.reset();
+            hand = board | deck.deal(2);
+        }
 
-            if (botEval > opponentEval)
+        std::array<uint32_t, CHUNK> opponentScores;
+        evaluator.evaluateBatch(opponentHands.data(), opponentScores.data(), CHUNK);
+
+        int wins = 0;
+        int ties = 0;
+        for (uint32_t opponentScore : opponentScores) {
+            if (botScore > opponentScore)
                 ++wins;
-            else if (botEval == opponentEval)
+            else if (botScore == opponentScore)
                 ++ties;
         }
-        return {wins, ties};
+        results[chunk] = {wins, ties};
     };
 
-    for (int i = 0; i < threads; ++i) {
-        futures.push_back(std::async(std::launch::async, simulate));
-    }
-
     int totalWins = 0;
     int totalTies = 0;
-    for (auto& f : futures) {
-        auto [wins, ties] = f.get();
-        totalWins += wins;
-        totalTies += ties;
+    int done = 0;
+    const double alpha = 1.0 - CONFIDENCE;
+    for (int look = 1; done < MAX_CHUNKS; ++look) {
+        const int next = std::min(MAX_CHUNKS, std::max(FIRST_ROUND_CHUNKS, 2 * done));
+        for (int c = done; c < next; ++c)
+            streams[c] = master.split();
+
+        // Passed by reference, so the std::function holds no copy
+        first = done;
+        WorkStealingPool::shared().run(next - done, std::cref(simulate));
+        for (int c = done; c < next; ++c) {
+            totalWins += results[c].first;
+            totalTies += results[c].second;
+        }
+        done = next;
+
+        const double trials = done * CHUNK;
+        const double z = PokerMath::zScore(1.0 - std::ldexp(alpha, -look));
+        if (PokerMath::intervalSettled(totalWins / trials, PokerMath::winRateMargin(totalWins, trials, trials, z),
+                                       HALF_WIDTH, CALL_THRESHOLD))
+            break;
     }
+    const int simulations = done * CHUNK;
+
+    // Show Monte Carlo simulation header
+    BotThinkingVisualizer::showMonteCarloHeader(simulations);
     
     int totalLosses = simulations - totalWins - totalTies;
     double winRate = static_cast<double>(totalWins) / simulations;
@@ -259,13 +311,13 @@ bool BotPlayer::shouldCallHardPlus(const std::vector<Card>& fullHand) {
     // Calculate confidence interval (95% confidence)
     // Using binomial distribution: σ = sqrt(p(1-p)/n)
     double stdDev = std::sqrt(winRate * (1.0 - winRate) / simulations);
-    double margin = 1.96 * stdDev;  // 95% confidence = 1.96 z-score
+    double margin = PokerMath::zScore(CONFIDENCE) * stdDev;
     double lowerBound = std::max(0.0, winRate - margin);
     double upperBound = std::min(1.0, winRate + margin);
     
     // Show Monte Carlo results with confidence interval
     BotThinkingVisualizer::showMonteCarloResult(winRate, totalWins, totalLosses, totalTies, simulations);
-    BotThinkingVisualizer::showConfidenceInterval(lowerBound, upperBound, 0.95);
+    BotThinkingVisualizer::showConfidenceInterval(lowerBound, upperBound, CONFIDENCE);
     
     // Calculate pot odds and expected value
     const int POT_SIZE = 200;  // Current pot
@@ -284,95 +336,57 @@ bool BotPlayer::shouldCallHardPlus(const std::vector<Card>& fullHand) {
     // Make decision based on EV and Kelly
     // EV > 0 means profitable call
     // Kelly > 0 means positive edge
-    bool decision = (ev > 0) && (winRate >= 0.4);
+    bool decision = (ev > 0) && (winRate >= CALL_THRESHOLD);
     
-    std::string reasoning;
+    // Formatted in place so a decision does not allocate
+    char reasoning[96];
     if (ev > 20 && kelly > 0.2) {
-        reasoning = "Strong EV (" + std::to_string(static_cast<int>(ev)) + " chips) + " +
-                   "Kelly suggests " + std::to_string(static_cast<int>(kelly * 100)) + "% - " +
-                   "CALLING confidently";
+        std::snprintf(reasoning, sizeof reasoning,
+                      "Strong EV (%d chips) + Kelly suggests %d%% - CALLING confidently",
+                      static_cast<int>(ev), static_cast<int>(kelly * 100));
     } else if (ev > 0 && kelly > 0) {
-        reasoning = "Positive EV (" + std::to_string(static_cast<int>(ev)) + " chips) - " +
-                   "Profitable call";
-    } else if (winRate >= 0.4) {
-        reasoning = "Win rate above threshold (40%) - Marginal call";
+        std::snprintf(reasoning, sizeof reasoning, "Positive EV (%d chips) - Profitable call",
+                      static_cast<int>(ev));
+    } else if (winRate >= CALL_THRESHOLD) {
+        std::snprintf(reasoning, sizeof reasoning, "Win rate above threshold (40%%) - Marginal call");
     } else {
-        reasoning = "Negative EV (" + std::to_string(static_cast<int>(ev)) + " chips) - " +
-                   "FOLDING";
+        std::snprintf(reasoning, sizeof reasoning, "Negative EV (%d chips) - FOLDING",
+                      static_cast<int>(ev));
     }
     
     BotThinkingVisualizer::showFinalDecision(decision, reasoning);
     
     // Stop performance monitoring
-    PerformanceMonitor::stop("MonteCarlo_Simulation");
+    PerformanceMonitor::stop(SIMULATION_TIMER);
     
     return decision;
 }
 
 // New helper methods for hand evaluation
-bool BotPlayer::hasDrawingHand(const std::vector<Card>& fullHand) const {
+bool BotPlayer::hasDrawingHand(CardSpan fullHand) const {
     return hasFlushDraw(fullHand) || hasStraightDraw(fullHand);
 }
 
-bool BotPlayer::hasFlushDraw(const std::vector<Card>& fullHand) const {
-    // Count cards by suit
-    std::map<Suit, int> suitCount;
-    for (const Card& c : fullHand) {
-        suitCount[c.suit]++;
-    }
-    
+bool BotPlayer::hasFlushDraw(CardSpan fullHand) const {
     // 4 cards of same suit is a flush draw
-    for (const auto& [suit, count] : suitCount) {
-        if (count == 4) {
+    const CardSet cards = CardSet::fromCards(fullHand);
+    for (int suit = 0; suit < 4; ++suit) {
+        if (rankCountOf(cards.suitMask(suit)) == 4) {
             return true;
         }
     }
     return false;
 }
 
-bool BotPlayer::hasStraightDraw(const std::vector<Card>& fullHand) const {
-    std::vector<int> ranks;
-    for (const Card& c : fullHand) {
-        ranks.push_back(static_cast<int>(c.rank));
-    }
-    
-    // Get unique ranks
-    std::sort(ranks.begin(), ranks.end());
-    auto last = std::unique(ranks.begin(), ranks.end());
-    ranks.erase(last, ranks.end());
-    
-    // Check for 4 sequential cards (open-ended straight draw)
-    int consecutive = 1;
-    int maxConsecutive = 1;
-    
-    for (size_t i = 1; i < ranks.size(); ++i) {
-        if (ranks[i] == ranks[i-1] + 1) {
-            consecutive++;
-            maxConsecutive = std::max(maxConsecutive, consecutive);
-        } else if (ranks[i] > ranks[i-1] + 1) {
-            consecutive = 1;
-        }
-    }
-    
-    // Also check for gutshot straight draws (3 sequential cards with a gap)
-    bool hasGutshot = false;
-    for (size_t i = 0; i < ranks.size() - 3; ++i) {
-        if ((ranks[i+1] == ranks[i] + 1) && 
-            (ranks[i+2] == ranks[i] + 2) && 
-            (ranks[i+3] == ranks[i] + 3)) {
-            hasGutshot = true;
-            break;
-        }
-    }
-    
-    return (maxConsecutive >= 4) || hasGutshot;
+bool BotPlayer::hasStraightDraw(CardSpan fullHand) const {
+    // Four sequential ranks (open-ended or at either end of the deck)
+    const CardSet cards = CardSet::fromCards(fullHand);
+    const uint32_t ranks = cards.suitMask(0) | cards.suitMask(1) | cards.suitMask(2) | cards.suitMask(3);
+    return (ranks & (ranks >> 1) & (ranks >> 2) & (ranks >> 3)) != 0;
 }
 
 // Bluffing logic
 bool BotPlayer::shouldBluff(HandRank handRank) const {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    
     int bluffChance;
     switch (handRank) {
         case HandRank::HighCard:
@@ -386,5 +400,5 @@ bool BotPlayer::shouldBluff(HandRank handRank) const {
     }
     
     std::uniform_int_distribution<> dis(1, 100);
-    return dis(gen) <= bluffChance;
+    return dis(rng) <= bluffChance;
 }
\ No newline at end of file
@@ -4,6 +4,8 @@
 #include "player.h"
 #include "hand_types.h"
 #include "advanced_hand_evaluator.h"
+#include "eval_state.h"
+#include "rng.h"
 #include <vector>
 #include <string>
 #include <random>
@@ -28,18 +30,19 @@ class BotPlayer : public Player
 {
 private:
     BotDifficulty difficulty;
-    mutable std::mt19937 rng;  // Mersenne Twister RNG (mutable for const methods)
+    mutable Rng rng;           // xoshiro256** stream (mutable for const methods)
+    EvalState handState;       // cards seen so far this hand, evaluated incrementally
 
     // basic decision making methods
     bool shouldCallEasy() const;
-    bool shouldCallMedium(const HandValue& eval, GameStage stage, const std::vector<Card>& fullHand) const;
-    bool shouldCallHard(const HandValue& eval, GameStage stage, const std::vector<Card>& fullHand) const;
-    bool shouldCallHardPlus(const std::vector<Card>& fullHand);
+    bool shouldCallMedium(const HandValue& eval, GameStage stage, CardSpan fullHand) const;
+    bool shouldCallHard(const HandValue& eval, GameStage stage, CardSpan fullHand) const;
+    bool shouldCallHardPlus(CardSpan fullHand);
 
     // hand strength awareness methods
-    bool hasDrawingHand(const std::vector<Card>& fullHand) const;
-    bool hasFlushDraw(const std::vector<Card>& fullHand) const;
-    bool hasStraightDraw(const std::vector<Card>& fullHand) const;
+    bool hasDrawingHand(CardSpan fullHand) const;
+    bool hasFlushDraw(CardSpan fullHand) const;
+    bool hasStraightDraw(CardSpan fullHand) const;
 
     // Bluffing Logic
     bool shouldBluff(HandRank handRank) const;
@@ -49,7 +52,7 @@ public:
 
     BotDifficulty getDifficulty() const;
 
-    bool shouldCallBet(const std::vector<Card> &fullHand, GameStage stage = GameStage::River);
+    bool shouldCallBet(CardSpan fullHand, GameStage stage = GameStage::River);
 };
 
 #endif
\ No newline at end of file
@@ -37,6 +37,7 @@ public:
 	Suit suit;
 	Rank rank;
 
+	Card() : suit(Suit::Hearts), rank(Rank::Two) {} // placeholder slot in fixed-size card arrays
 	Card(Suit s, Rank r);
 	Card(Rank r, Suit s) : suit(s), rank(r) {}
 
@@ -0,0 +1,94 @@
+#ifndef CARD_LIST_H
+#define CARD_LIST_H
+
+#include "card.h"
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * CardList<N> - up to N cards in the order they were dealt, stored inline
+ *
+ * Stands in for std::vector<Card> wherever the largest hand is known up
+ * front (hole cards, the board, both together), so holding and passing
+ * hands never touches the heap. Adding past the capacity throws
+ * std::length_error.
+ */
+template <size_t Capacity>
+class CardList
+{
+public:
+    CardList() = default;
+
+    CardList(std::initializer_list<Card> cards)
+    {
+        for (const Card &c : cards)
+            push_back(c);
+    }
+
+    void push_back(const Card &card)
+    {
+        if (count == Capacity)
+            throw std::length_error("CardList is full");
+        cards[count++] = card;
+    }
+
+    void clear() { count = 0; }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    static constexpr size_t capacity() { return Capacity; }
+
+    const Card *data() const { return cards; }
+    const Card *begin() const { return cards; }
+    const Card *end() const { return cards + count; }
+    const Card &operator[](size_t i) const { return cards[i]; }
+
+private:
+    Card cards[Capacity];
+    size_t count = 0;
+};
+
+// Hole cards (four in Omaha), the board, and the two together
+using HoleCards = CardList<4>;
+using CommunityCards = CardList<5>;
+using FullHand = CardList<9>;
+
+/**
+ * CardSpan - read-only view of cards stored one after another
+ *
+ * Functions that only read a hand take a CardSpan, so a std::vector<Card>
+ * or a CardList can be passed without a copy. The view does
+ * not own the cards and must not outlive them.
+ */
+class CardSpan
+{
+public:
+    CardSpan() = default;
+    CardSpan(const Card *first, size_t count) : first(first), count(count) {}
+    CardSpan(const std::vector<Card> &cards) : first(cards.data()), count(cards.size()) {}
+
+    template <size_t N>
+    CardSpan(const CardList<N> &cards) : first(cards.data()), count(cards.size()) {}
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    const Card *data() const { return first; }
+    const Card *begin() const { return first; }
+    const Card *end() const { return first + count; }
+    const Card &operator[](size_t i) const { return first[i]; }
+
+    // The cards from `offset` on, e.g. the board part of hole + board
+    CardSpan from(size_t offset) const
+    {
+        return offset < count ? CardSpan(first + offset, count - offset) : CardSpan();
+    }
+
+private:
+    const Card *first = nullptr;
+    size_t count = 0;
+};
+
+#endif // CARD_LIST_H
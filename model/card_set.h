@@ -0,0 +1,123 @@
+#ifndef CARD_SET_H
+#define CARD_SET_H
+
+#include "card.h"
+#include "card_list.h"
+#include <cstdint>
+#include <vector>
+
+// Dense card index 0..51: 13 * suit + (rank - 2)
+using CardId = uint8_t;
+
+inline CardId toCardId(const Card &c)
+{
+    return static_cast<CardId>(13 * static_cast<int>(c.suit) + (static_cast<int>(c.rank) - 2));
+}
+
+inline Card cardOf(CardId id)
+{
+    return Card(static_cast<Rank>(id % 13 + 2), static_cast<Suit>(id / 13));
+}
+
+/**
+ * CardSet - a set of cards packed into one 64-bit word
+ *
+ * Each suit owns a 16-bit lane and each rank one bit inside it:
+ *   bit = 16 * suit + (rank - 2)
+ * so the per-suit 13-bit rank masks fall out with a shift and a mask.
+ * Insert, remove, membership and size are single bit operations, and
+ * iterating yields the CardIds in increasing order:
+ *
+ *     for (CardId id : CardSet::fullDeck().without(dead))
+ *         ...
+ */
+struct CardSet
+{
+    static constexpr uint64_t RANK_MASK = 0x1FFF;
+
+    uint64_t bits = 0;
+
+    static int bitIndex(const Card &c)
+    {
+        return 16 * static_cast<int>(c.suit) + (static_cast<int>(c.rank) - 2);
+    }
+
+    static int bitIndex(CardId id) { return 16 * (id / 13) + id % 13; }
+
+    static CardSet of(CardId id) { return CardSet{uint64_t(1) << bitIndex(id)}; }
+
+    static CardSet fromCards(CardSpan cards)
+    {
+        CardSet set;
+        for (const Card &c : cards)
+            set.add(c);
+        return set;
+    }
+
+    // Every card from `lowestRank` up in all four suits (36 cards from the Six)
+    static CardSet fullDeck(int lowestRank = 2)
+    {
+        uint64_t suit = RANK_MASK & ~((uint64_t(1) << (lowestRank - 2)) - 1);
+        return CardSet{suit * 0x0001000100010001ull};
+    }
+
+    void add(const Card &c) { bits |= uint64_t(1) << bitIndex(c); }
+    void add(CardId id) { bits |= uint64_t(1) << bitIndex(id); }
+    void remove(CardId id) { bits &= ~(uint64_t(1) << bitIndex(id)); }
+
+    bool contains(const Card &c) const { return (bits >> bitIndex(c)) & 1; }
+    bool contains(CardId id) const { return (bits >> bitIndex(id)) & 1; }
+
+    int size() const { return __builtin_popcountll(bits); }
+    bool empty() const { return bits == 0; }
+
+    CardSet without(CardSet other) const { return CardSet{bits & ~other.bits}; }
+    bool intersects(CardSet other) const { return (bits & other.bits) != 0; }
+
+    CardSet operator|(CardSet other) const { return CardSet{bits | other.bits}; }
+    CardSet &operator|=(CardSet other)
+    {
+        bits |= other.bits;
+        return *this;
+    }
+    bool operator==(CardSet other) const { return bits == other.bits; }
+    bool operator!=(CardSet other) const { return bits != other.bits; }
+
+    std::vector<Card> toCards() const
+    {
+        std::vector<Card> cards;
+        cards.reserve(size());
+        for (CardId id : *this)
+            cards.push_back(cardOf(id));
+        return cards;
+    }
+
+    // Visits the set bits lowest first, clearing one per step
+    struct Iterator
+    {
+        uint64_t rest;
+
+        CardId operator*() const
+        {
+            int bit = __builtin_ctzll(rest);
+            return static_cast<CardId>(13 * (bit >> 4) + (bit & 15));
+        }
+        Iterator &operator++()
+        {
+            rest &= rest - 1;
+            return *this;
+        }
+        bool operator!=(const Iterator &other) const { return rest != other.rest; }
+    };
+
+    Iterator begin() const { return Iterator{bits}; }
+    Iterator end() const { return Iterator{0}; }
+
+    // 13-bit mask of the ranks held in one suit (bit 0 = Two, bit 12 = Ace)
+    uint32_t suitMask(int suit) const
+    {
+        return static_cast<uint32_t>((bits >> (16 * suit)) & RANK_MASK);
+    }
+};
+
+#endif // CARD_SET_H
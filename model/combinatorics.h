@@ -0,0 +1,214 @@
+#ifndef COMBINATORICS_H
+#define COMBINATORICS_H
+
+#include "card_set.h"
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * Compile-time binomial coefficients C(n, k) for n <= 52 and k <= 7, the
+ * largest subsets a hand or board ever needs
+ */
+struct BinomialTable
+{
+    static constexpr int MAX_N = 52;
+    static constexpr int MAX_K = 7;
+
+    uint64_t value[MAX_N + 1][MAX_K + 1];
+
+    constexpr BinomialTable() : value()
+    {
+        for (int n = 0; n <= MAX_N; ++n)
+        {
+            value[n][0] = 1;
+            for (int k = 1; k <= MAX_K; ++k)
+                value[n][k] = n == 0 ? 0 : value[n - 1][k - 1] + value[n - 1][k];
+        }
+    }
+};
+
+inline constexpr BinomialTable BINOMIALS{};
+
+// 0 outside the table, so no caller can read past it
+constexpr uint64_t choose(int n, int k)
+{
+    return n < 0 || n > BinomialTable::MAX_N || k < 0 || k > BinomialTable::MAX_K ? 0 : BINOMIALS.value[n][k];
+}
+
+/**
+ * Colex - dense indices for card subsets
+ *
+ * A k-card subset with cards c1 < c2 < ... < ck (as positions 0..n-1) has
+ * colex rank C(c1, 1) + C(c2, 2) + ... + C(ck, k), a bijection onto
+ * [0, C(n, k)): hole pairs index 0..1325, flops 0..22099. Positions are
+ * either CardIds (the full deck) or the order of the cards within a
+ * `live` set, so subsets that avoid dead cards still get dense indices.
+ */
+class Colex
+{
+public:
+    static uint64_t rank(CardSet cards)
+    {
+        uint64_t r = 0;
+        int i = 1;
+        for (CardId id : cards)
+            r += choose(id, i++);
+        return r;
+    }
+
+    static uint64_t rank(CardSet cards, CardSet live)
+    {
+        uint64_t r = 0;
+        int i = 1;
+        for (CardId id : cards)
+        {
+            // Position among the live cards = live cards below this one
+            uint64_t below = live.bits & ((uint64_t(1) << CardSet::bitIndex(id)) - 1);
+            r += choose(__builtin_popcountll(below), i++);
+        }
+        return r;
+    }
+
+    // Throws std::out_of_range unless rank < C(52, k)
+    static CardSet unrank(uint64_t rank, int k)
+    {
+        if (rank >= choose(52, k))
+            throw std::out_of_range("Colex rank out of range");
+
+        CardSet set;
+        int c = 52;
+        for (int i = k; i >= 1; --i)
+        {
+            // Largest position c with C(c, i) <= rank
+            do
+                --c;
+            while (choose(c, i) > rank);
+            set.add(static_cast<CardId>(c));
+            rank -= choose(c, i);
+        }
+        return set;
+    }
+
+    // Throws std::out_of_range unless rank < C(live.size(), k)
+    static CardSet unrank(uint64_t rank, int k, CardSet live);
+};
+
+/**
+ * SubsetRange - the k-card subsets of a live set, in colex order
+ *
+ * Covers the ranks [first, last) of Colex::rank(subset, live) and iterates
+ * them by stepping a bit mask over live positions with Gosper's hack, so
+ * each step is a few word operations. split() cuts the range into
+ * contiguous pieces for parallel workers:
+ *
+ *     for (const SubsetRange &part : SubsetRange(deck.without(dead), 2).split(threads))
+ *         workers.emplace_back([&part] { for (CardSet hole : part) ...; });
+ *
+ * In colex order the highest cards change slowest, so subsets that share
+ * all but their lowest cards come out next to each other.
+ */
+class SubsetRange
+{
+public:
+    SubsetRange(CardSet live, int k) : SubsetRange(live, k, 0, 0)
+    {
+        last = choose(liveCount, k);
+    }
+
+    SubsetRange(CardSet live, int k, uint64_t first, uint64_t last)
+        : live(live), k(k), first(first), last(last)
+    {
+        for (CardId id : live)
+            cardBits[liveCount++] = CardSet::of(id).bits;
+    }
+
+    uint64_t size() const { return last - first; }
+
+    // `parts` contiguous ranges covering this one, sizes differing by at most 1
+    std::vector<SubsetRange> split(int parts) const
+    {
+        std::vector<SubsetRange> pieces;
+        for (int p = 0; p < parts; ++p)
+        {
+            uint64_t from = first + size() * p / parts;
+            uint64_t to = first + size() * (p + 1) / parts;
+            pieces.push_back(SubsetRange(*this, from, to));
+        }
+        return pieces;
+    }
+
+    struct Iterator
+    {
+        const SubsetRange *range;
+        uint64_t mask; // bit j set when live card j is in the subset
+        uint64_t index;
+
+        CardSet operator*() const
+        {
+            CardSet set;
+            for (uint64_t m = mask; m; m &= m - 1)
+                set.bits |= range->cardBits[__builtin_ctzll(m)];
+            return set;
+        }
+
+        Iterator &operator++()
+        {
+            // Gosper's hack: the next larger integer with as many set bits,
+            // dividing by the lowest bit as a shift
+            if (mask)
+            {
+                uint64_t ripple = mask + (mask & -mask);
+                mask = (((ripple ^ mask) >> 2) >> __builtin_ctzll(mask)) | ripple;
+            }
+            ++index;
+            return *this;
+        }
+
+        bool operator!=(const Iterator &other) const { return index != other.index; }
+    };
+
+    Iterator begin() const { return Iterator{this, first < last ? positionsOf(first) : 0, first}; }
+    Iterator end() const { return Iterator{this, 0, last}; }
+
+private:
+    CardSet live;
+    int k;
+    uint64_t first;
+    uint64_t last;
+    uint64_t cardBits[52]; // CardSet bit of each live position
+    int liveCount = 0;
+
+    SubsetRange(const SubsetRange &whole, uint64_t from, uint64_t to) : SubsetRange(whole)
+    {
+        first = from;
+        last = to;
+    }
+
+    // Live positions of the subset with this rank, as a mask
+    uint64_t positionsOf(uint64_t rank) const
+    {
+        uint64_t mask = 0;
+        int c = liveCount;
+        for (int i = k; i >= 1; --i)
+        {
+            do
+                --c;
+            while (choose(c, i) > rank);
+            mask |= uint64_t(1) << c;
+            rank -= choose(c, i);
+        }
+        return mask;
+    }
+};
+
+inline CardSet Colex::unrank(uint64_t rank, int k, CardSet live)
+{
+    if (rank >= choose(live.size(), k))
+        throw std::out_of_range("Colex rank out of range");
+
+    SubsetRange range(live, k, rank, rank + 1);
+    return *range.begin();
+}
+
+#endif // COMBINATORICS_H
@@ -0,0 +1,122 @@
+// deal_generator.cpp
+#include "deal_generator.h"
+#include <stdexcept>
+#include <utility>
+
+DealGenerator::DealGenerator(int seats, uint64_t seed, GameVariant variant, int dealsPerBlock)
+    : seatCount(seats), holeCount(holeCardCount(variant)), stride(holeCount * seats + 5), dealsPerBlock(dealsPerBlock),
+      lanes([&]() -> RngLanes {
+          Rng master(seed);
+          return RngLanes(master);
+      }()),
+      spare(Rng::stream(seed, RngLanes::LANES))
+{
+    for (CardId id : CardSet::fullDeck(lowestRank(variant)))
+        pool[poolSize++] = id;
+
+    if (seats < 1 || stride > poolSize)
+        throw std::invalid_argument("Not enough cards to deal every seat and the board");
+    if (dealsPerBlock < 1)
+        throw std::invalid_argument("A block needs at least one deal");
+
+    for (std::vector<CardId> &block : ring)
+        block.resize(static_cast<size_t>(dealsPerBlock) * stride);
+
+    // Two 32-bit draws per output, rounded up to whole lane steps
+    size_t outputs = (static_cast<size_t>(dealsPerBlock) * stride + 1) / 2;
+    randoms.resize((outputs + RngLanes::LANES - 1) / RngLanes::LANES * RngLanes::LANES);
+
+    producer = std::thread(&DealGenerator::produce, this);
+}
+
+DealGenerator::~DealGenerator()
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    freed.notify_all();
+    producer.join();
+}
+
+void DealGenerator::produce()
+{
+    for (;;)
+    {
+        uint64_t slot;
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            freed.wait(guard, [&] { return stopping || produced - released < RING; });
+            if (stopping)
+                return;
+            slot = produced % RING;
+        }
+
+        // Blocks from `released` up to `produced` are not touched by the consumer
+        fillBlock(ring[slot].data());
+
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            produced++;
+        }
+        filled.notify_one();
+    }
+}
+
+/**
+ * Deal one block. Every deal is a fresh partial Fisher–Yates pass over the
+ * whole pool; the pool's order left by the previous deal does not matter
+ * because each pick is uniform over the cards not yet taken.
+ */
+void DealGenerator::fillBlock(CardId *out)
+{
+    lanes.fill(randoms.data(), randoms.size());
+
+    size_t draw = 0;
+    for (int d = 0; d < dealsPerBlock; ++d)
+    {
+        int remaining = poolSize;
+        for (int c = 0; c < stride; ++c, ++draw)
+        {
+            // Lemire's reduction of a 32-bit draw to [0, remaining)
+            const uint32_t n = static_cast<uint32_t>(remaining);
+            uint32_t r = static_cast<uint32_t>(randoms[draw >> 1] >> (32 * (draw & 1)));
+            uint64_t product = uint64_t(r) * n;
+            if (static_cast<uint32_t>(product) < n)
+            {
+                const uint32_t threshold = -n % n;
+                while (static_cast<uint32_t>(product) < threshold)
+                    product = (spare() >> 32) * n;
+            }
+
+            int pick = static_cast<int>(product >> 32);
+            --remaining;
+            std::swap(pool[pick], pool[remaining]);
+            *out++ = pool[remaining];
+        }
+    }
+}
+
+DealGenerator::Block DealGenerator::nextBlock()
+{
+    std::unique_lock<std::mutex> guard(lock);
+    if (holding)
+    {
+        released++;
+        freed.notify_one();
+    }
+    filled.wait(guard, [&] { return produced > consumed; });
+
+    current = Block{ring[consumed % RING].data(), dealsPerBlock, seatCount, holeCount};
+    consumed++;
+    holding = true;
+    position = 0;
+    return current;
+}
+
+DealGenerator::Deal DealGenerator::next()
+{
+    if (!holding || position == current.count)
+        nextBlock();
+    return current.deal(position++);
+}
@@ -0,0 +1,114 @@
+#ifndef DEAL_GENERATOR_H
+#define DEAL_GENERATOR_H
+
+#include "card_set.h"
+#include "game_variant.h"
+#include "rng.h"
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * DealGenerator - complete deals produced ahead of time on a worker thread
+ *
+ * A deal is the hole cards of every seat (two, or four in Omaha) followed
+ * by the five board cards, stored as holeCards * seats + 5 CardIds. A producer thread fills fixed blocks of
+ * deals in a small ring, drawing its random numbers from RngLanes, while
+ * the consumer only reads finished blocks. Each deal is a partial
+ * Fisher–Yates draw over the variant's deck.
+ *
+ * The sequence depends only on the seed, seat count, variant and block
+ * size, never on thread timing, so a seed replays the same deals.
+ */
+class DealGenerator
+{
+public:
+    // A seat's hole cards, viewed in place
+    struct Hole
+    {
+        const CardId *first;
+        int count;
+
+        int size() const { return count; }
+        const CardId *begin() const { return first; }
+        const CardId *end() const { return first + count; }
+        CardId operator[](int i) const { return first[i]; }
+    };
+
+    // One deal; seat s holds cards[h * s] to cards[h * s + h - 1] for h
+    // hole cards a seat, and the board follows
+    struct Deal
+    {
+        const CardId *cards;
+        int seats;
+        int holeCards;
+
+        Hole hole(int seat) const { return Hole{cards + holeCards * seat, holeCards}; }
+        CardId board(int i) const { return cards[holeCards * seats + i]; }
+    };
+
+    // `count` deals stored back to back
+    struct Block
+    {
+        const CardId *cards;
+        int count;
+        int seats;
+        int holeCards;
+
+        Deal deal(int i) const { return Deal{cards + i * (holeCards * seats + 5), seats, holeCards}; }
+    };
+
+    DealGenerator(int seats, uint64_t seed, GameVariant variant = GameVariant::Holdem,
+                  int dealsPerBlock = 1024);
+    ~DealGenerator();
+
+    DealGenerator(const DealGenerator &) = delete;
+    DealGenerator &operator=(const DealGenerator &) = delete;
+
+    // The next block; the previous one goes back to the producer
+    Block nextBlock();
+
+    // The next deal, taken from the current block
+    Deal next();
+
+    int seats() const { return seatCount; }
+    int holeCards() const { return holeCount; }
+
+private:
+    static constexpr int RING = 3;
+
+    const int seatCount;
+    const int holeCount;
+    const int stride;
+    const int dealsPerBlock;
+    std::vector<CardId> ring[RING];
+
+    // Producer state
+    std::array<CardId, 52> pool;
+    int poolSize = 0;
+    RngLanes lanes;
+    Rng spare; // the rare draws Lemire's rejection asks for
+    std::vector<uint64_t> randoms;
+
+    // Consumer state
+    Block current{nullptr, 0, 0, 0};
+    int position = 0;
+    bool holding = false;
+
+    std::mutex lock;
+    std::condition_variable filled;
+    std::condition_variable freed;
+    uint64_t produced = 0; // blocks finished by the producer
+    uint64_t consumed = 0; // blocks handed to the consumer
+    uint64_t released = 0; // blocks handed back
+    bool stopping = false;
+    std::thread producer;
+
+    void produce();
+    void fillBlock(CardId *out);
+};
+
+#endif // DEAL_GENERATOR_H
@@ -1,53 +1,86 @@
 #include "deck.h"
+#include <algorithm>
+#include <cstdlib>
 #include <iostream>
 
-Deck::Deck()
+Deck::Deck(GameVariant variant, CardSet dead) : Deck(variant, dead, Rng::nextStream())
 {
-	rng.seed(static_cast<unsigned int>(std::time(nullptr)));
+}
+
+Deck::Deck(GameVariant variant, CardSet dead, const Rng &stream) : variant(variant), rng(stream)
+{
+	reset(dead);
+}
+
+void Deck::reset()
+{
+	remaining = liveCount;
+}
 
-	// popularte deck with 52 cards
-	for (int s = 0; s < 4; ++s)
+void Deck::reset(CardSet dead)
+{
+	// popularte deck with 52 cards, or 36 from the Six up for short deck
+	live = CardSet::fullDeck(lowestRank(variant)).without(dead);
+	liveCount = 0;
+	for (CardId id : live)
 	{
-		for (int r = 2; r <= 14; ++r)
-		{
-			cards.emplace_back(
-				static_cast<Suit>(s),
-				static_cast<Rank>(r));
-		}
+		cards[liveCount++] = id;
 	}
+	remaining = liveCount;
+}
+
+void Deck::seed(uint64_t value)
+{
+	seed(Rng(value));
+}
 
-	shuffle();
+void Deck::seed(const Rng &stream)
+{
+	rng = stream;
+	reset(CardSet::fullDeck(lowestRank(variant)).without(live));
 }
 
 void Deck::shuffle()
 {
-	std::shuffle(cards.begin(), cards.end(), rng);
+	std::shuffle(cards.begin(), cards.begin() + remaining, rng);
 }
 
-Card Deck::dealCard()
+CardId Deck::dealId()
 {
-	if (cards.empty())
+	if (remaining == 0)
 	{
 		std::cerr << "Error: Tried to deal a card from an empty deck.\n";
 		exit(EXIT_FAILURE);
 	}
 
-	Card topCard = cards.back();
-	cards.pop_back();
-	return topCard;
+	// One Fisher–Yates step: a random live card moves to the dealt end
+	int pick = static_cast<int>(rng.below(static_cast<uint32_t>(remaining)));
+	--remaining;
+	std::swap(cards[pick], cards[remaining]);
+	return cards[remaining];
+}
+
+Card Deck::dealCard()
+{
+	return cardOf(dealId());
+}
+
+CardSet Deck::deal(int count)
+{
+	CardSet dealt;
+	for (int i = 0; i < count; ++i)
+	{
+		dealt.add(dealId());
+	}
+	return dealt;
 }
 
 bool Deck::isEmpty() const
 {
-	return cards.empty();
+	return remaining == 0;
 }
 
 int Deck::size() const
 {
-	return static_cast<int>(cards.size());
+	return remaining;
 }
-
-/**
- * emplace_back = modern method to add elements to a vector, more efficient than
- * push_back() when constructing objects
- **/
\ No newline at end of file
@@ -2,23 +2,49 @@
 #define DECK_H
 
 #include "card.h"
-#include <vector>
-#include <random>
-#include <algorithm>
-#include <ctime>
+#include "card_set.h"
+#include "game_variant.h"
+#include "rng.h"
+#include <array>
+#include <cstdint>
 
+/**
+ * Deck - the cards left to deal, drawn one partial Fisher–Yates step at a time
+ *
+ * The live cards (the variant's deck minus any dead cards) sit in a fixed
+ * array. Dealing swaps a uniformly chosen live card to the end of the live
+ * range and shrinks it, so dealing k cards costs k steps and no full
+ * shuffle is ever needed. reset() returns every dealt card in O(1); since
+ * each deal is uniform over what is left, the order they come back in does
+ * not matter. Nothing allocates after construction.
+ */
 class Deck
 {
 private:
-	std::vector<Card> cards;
-	std::mt19937 rng; // Mersenne Twister random number generator
+	GameVariant variant;
+	CardSet live;	   // cards in a full deck (dead cards excluded)
+	std::array<CardId, 52> cards;
+	int liveCount = 0;
+	int remaining = 0; // cards[0, remaining) are still to be dealt
+	Rng rng;		   // Rng::nextStream() unless a stream was given
 
 public:
-	Deck();				  // Constructor: builds and shuffles the deck
-	void shuffle();		  // Reshuffles the deck
-	Card dealCard();	  // Deals one card
-	bool isEmpty() const; // Checks if the deck is empty
-	int size() const;	  // Number of cards remaining
+	// builds the deck (36 cards for short deck), leaving out `dead`
+	explicit Deck(GameVariant variant = GameVariant::Holdem, CardSet dead = CardSet{});
+	// the same, dealing from `stream`; skips the lock and jump of
+	// Rng::nextStream() for decks that are seeded per use
+	Deck(GameVariant variant, CardSet dead, const Rng &stream);
+	void reset();				// Puts every dealt card back
+	void reset(CardSet dead);	// Puts every card back except `dead`
+	void seed(uint64_t value);	// Puts every card back in a fixed order, so a seed
+								// always deals the same sequence
+	void seed(const Rng &stream); // The same, dealing from `stream`
+	void shuffle();				// Reshuffles the cards not yet dealt
+	Card dealCard();			// Deals one card
+	CardId dealId();			// Deals one card as a CardId
+	CardSet deal(int count);	// Deals `count` cards as a set
+	bool isEmpty() const;		// Checks if the deck is empty
+	int size() const;			// Number of cards remaining
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,92 @@
+#ifndef EVAL_STATE_H
+#define EVAL_STATE_H
+
+#include "bitmask_hand_evaluator.h"
+#include "card.h"
+#include "card_set.h"
+#include "hand_types.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * EvalState - a hand that is evaluated as cards arrive
+ *
+ * add() folds one card into the rank multiplicity masks and suit counts in
+ * O(1) and, from the fifth card on, refreshes the running best score. The
+ * state is a few plain words, so copying it to branch on every possible
+ * turn or river card is cheap:
+ *
+ *     EvalState flop = EvalState::of(holeAndFlop);
+ *     for (CardId turn : remaining)
+ *         score(flop.with(turn));
+ *
+ * Cards must be distinct; adding a card twice is not detected.
+ */
+class EvalState
+{
+public:
+    static EvalState of(CardSpan cards)
+    {
+        EvalState state;
+        for (const Card &c : cards)
+            state.add(c);
+        return state;
+    }
+
+    void add(const Card &c) { add(toCardId(c)); }
+
+    void add(CardId id)
+    {
+        const int suit = id / 13;
+        const uint32_t rankBit = 1u << (id % 13);
+        set.add(id);
+
+        // The first mask not yet holding this rank records the new count
+        if (!(atLeast[0] & rankBit))
+            atLeast[0] |= rankBit;
+        else if (!(atLeast[1] & rankBit))
+            atLeast[1] |= rankBit;
+        else if (!(atLeast[2] & rankBit))
+            atLeast[2] |= rankBit;
+        else
+            atLeast[3] |= rankBit;
+
+        if (++suitCount[suit] >= 5)
+            flush = set.suitMask(suit);
+
+        if (++count >= 5)
+            best = BitmaskHandEvaluator::evaluateMasks(atLeast[0], atLeast[1], atLeast[2],
+                                                       atLeast[3], flush);
+    }
+
+    // Copy of this state with one more card
+    EvalState with(CardId id) const
+    {
+        EvalState next = *this;
+        next.add(id);
+        return next;
+    }
+
+    bool contains(CardId id) const
+    {
+        return set.contains(id);
+    }
+
+    int size() const { return count; }
+    CardSet cards() const { return set; }
+
+    // Packed HandValue score of the best five cards; 0 below five cards
+    uint32_t score() const { return best; }
+    HandValue value() const { return HandValue::fromScore(best); }
+    HandRank category() const { return static_cast<HandRank>(best >> HandValue::CATEGORY_SHIFT); }
+
+private:
+    CardSet set;
+    uint32_t atLeast[4] = {0, 0, 0, 0}; // bit r set when rank r + 2 appears N+ times
+    uint32_t flush = 0;                 // ranks of a suit with five or more cards
+    uint8_t suitCount[4] = {0, 0, 0, 0};
+    uint8_t count = 0;
+    uint32_t best = 0;
+};
+
+#endif // EVAL_STATE_H
@@ -0,0 +1,153 @@
+// evaluator_registry.cpp
+#include "evaluator_registry.h"
+#include "advanced_hand_evaluator.h"
+#include "batch_hand_evaluator.h"
+#include "bitmask_hand_evaluator.h"
+#include "lookup_table_evaluator.h"
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+
+HandValue EvaluatorBackend::evaluate(CardSpan cards) const
+{
+    if (cards.size() < 5)
+    {
+        throw std::invalid_argument("At least 5 cards are required for hand evaluation");
+    }
+    return HandValue::fromScore(evaluate(CardSet::fromCards(cards)));
+}
+
+namespace
+{
+    class ScalarBackend : public EvaluatorBackend
+    {
+    public:
+        const char *name() const override { return "scalar"; }
+        bool supported() const override { return true; }
+        uint32_t evaluate(CardSet cards) const override { return BitmaskHandEvaluator::evaluate(cards); }
+        void evaluateBatch(const CardSet *hands, uint32_t *out, size_t n) const override
+        {
+            BatchHandEvaluator::evaluateScalar(hands, out, n);
+        }
+    };
+
+    class Bmi2Backend : public EvaluatorBackend
+    {
+    public:
+        const char *name() const override { return "bmi2"; }
+        bool supported() const override { return BatchHandEvaluator::bmi2Supported(); }
+        uint32_t evaluate(CardSet cards) const override { return BatchHandEvaluator::evaluateBmi2(cards); }
+        void evaluateBatch(const CardSet *hands, uint32_t *out, size_t n) const override
+        {
+            BatchHandEvaluator::evaluateBmi2(hands, out, n);
+        }
+    };
+
+    // The vector backends only pay off for batches; single hands stay scalar
+    class Avx2Backend : public EvaluatorBackend
+    {
+    public:
+        const char *name() const override { return "avx2"; }
+        bool supported() const override { return BatchHandEvaluator::avx2Supported(); }
+        uint32_t evaluate(CardSet cards) const override { return BitmaskHandEvaluator::evaluate(cards); }
+        void evaluateBatch(const CardSet *hands, uint32_t *out, size_t n) const override
+        {
+            BatchHandEvaluator::evaluateAvx2(hands, out, n);
+        }
+    };
+
+    class Avx512Backend : public EvaluatorBackend
+    {
+    public:
+        const char *name() const override { return "avx512"; }
+        bool supported() const override { return BatchHandEvaluator::avx512Supported(); }
+        uint32_t evaluate(CardSet cards) const override { return BitmaskHandEvaluator::evaluate(cards); }
+        void evaluateBatch(const CardSet *hands, uint32_t *out, size_t n) const override
+        {
+            BatchHandEvaluator::evaluateAvx512(hands, out, n);
+        }
+    };
+
+    class TableBackend : public EvaluatorBackend
+    {
+    public:
+        const char *name() const override { return "table"; }
+        bool supported() const override { return AdvancedHandEvaluator::mode() == EvaluatorMode::LookupTable; }
+
+        uint32_t evaluate(CardSet cards) const override
+        {
+            // Any other size would be truncated or scored as nonsense
+            if (cards.size() < 5 || cards.size() > 7)
+            {
+                throw std::invalid_argument("The lookup table evaluates 5 to 7 cards");
+            }
+
+            CardId ids[7];
+            size_t count = 0;
+            for (uint64_t bits = cards.bits; bits; bits &= bits - 1)
+            {
+                int bit = __builtin_ctzll(bits);
+                ids[count++] = static_cast<CardId>(13 * (bit / 16) + bit % 16);
+            }
+            return LookupTableEvaluator::evaluate(ids, count);
+        }
+
+        void evaluateBatch(const CardSet *hands, uint32_t *out, size_t n) const override
+        {
+            for (size_t i = 0; i < n; ++i)
+                out[i] = evaluate(hands[i]);
+        }
+    };
+
+    const ScalarBackend SCALAR;
+    const Bmi2Backend BMI2;
+    const Avx2Backend AVX2;
+    const Avx512Backend AVX512;
+    const TableBackend TABLE;
+
+    // CPU backends slowest first, then the table
+    const EvaluatorBackend *const BACKENDS[] = {&SCALAR, &BMI2, &AVX2, &AVX512, &TABLE};
+
+    const EvaluatorBackend &select()
+    {
+        const char *env = std::getenv("POKER_EVALUATOR");
+        if (env && *env)
+        {
+            if (const EvaluatorBackend *forced = EvaluatorRegistry::find(env))
+                return *forced;
+            std::cerr << "Warning: evaluator '" << env << "' is unknown or unsupported here, "
+                      << "choosing automatically\n";
+        }
+
+        // The fastest supported CPU backend; the table is opt-in
+        const EvaluatorBackend *best = &SCALAR;
+        for (const EvaluatorBackend *backend : BACKENDS)
+            if (backend != &TABLE && backend->supported())
+                best = backend;
+        return *best;
+    }
+}
+
+const EvaluatorBackend &EvaluatorRegistry::active()
+{
+    // Function-local static: selected once, thread-safely
+    static const EvaluatorBackend &selected = select();
+    return selected;
+}
+
+const EvaluatorBackend *EvaluatorRegistry::find(const std::string &name)
+{
+    for (const EvaluatorBackend *backend : BACKENDS)
+        if (name == backend->name())
+            return backend->supported() ? backend : nullptr;
+    return nullptr;
+}
+
+std::vector<const EvaluatorBackend *> EvaluatorRegistry::available()
+{
+    std::vector<const EvaluatorBackend *> backends;
+    for (const EvaluatorBackend *backend : BACKENDS)
+        if (backend->supported())
+            backends.push_back(backend);
+    return backends;
+}
@@ -0,0 +1,55 @@
+#ifndef EVALUATOR_REGISTRY_H
+#define EVALUATOR_REGISTRY_H
+
+#include "card.h"
+#include "card_set.h"
+#include "hand_types.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * One hand evaluator implementation
+ *
+ * Every backend returns the same packed HandValue scores; they differ only
+ * in the instructions they need and how fast they are on a given CPU.
+ */
+class EvaluatorBackend
+{
+public:
+    virtual ~EvaluatorBackend() = default;
+
+    virtual const char *name() const = 0;
+    virtual bool supported() const = 0;
+
+    // Packed score of one 5 to 7 card hand
+    virtual uint32_t evaluate(CardSet cards) const = 0;
+    virtual void evaluateBatch(const CardSet *hands, uint32_t *out, size_t n) const = 0;
+
+    // Convenience for callers holding Cards; throws below 5 cards
+    HandValue evaluate(CardSpan cards) const;
+};
+
+/**
+ * EvaluatorRegistry - picks the evaluator backend for this machine
+ *
+ * Backends: "scalar", "bmi2", "avx2", "avx512" and "table" (the mapped
+ * lookup table). On first use the fastest backend the CPU supports is
+ * selected from CPUID; setting POKER_EVALUATOR to a backend name forces
+ * that one instead, e.g. for benchmarking. The table is only used when
+ * asked for by name, since it needs the table file.
+ */
+class EvaluatorRegistry
+{
+public:
+    static const EvaluatorBackend &active();
+
+    // Backend by name, or nullptr if unknown or not supported here
+    static const EvaluatorBackend *find(const std::string &name);
+
+    // All backends usable on this machine: CPU ones slowest first, then the table
+    static std::vector<const EvaluatorBackend *> available();
+};
+
+#endif // EVALUATOR_REGISTRY_H
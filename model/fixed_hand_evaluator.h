@@ -0,0 +1,119 @@
+#ifndef FIXED_HAND_EVALUATOR_H
+#define FIXED_HAND_EVALUATOR_H
+
+#include "card_set.h"
+#include "hand_types.h"
+#include "rank_tables.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Evaluator specialized on the hand size at compile time
+ *
+ * evaluate<N> takes exactly N = 5, 6 or 7 CardIds, so the card loop has a
+ * constant trip count and unrolls, there is no size check and no vector.
+ * Straight, flush and kicker questions are answered from RANK_TABLES.
+ * Everything is constexpr; the scores equal BitmaskHandEvaluator's.
+ */
+class FixedHandEvaluator
+{
+public:
+    template <size_t N>
+    static constexpr uint32_t evaluate(const std::array<CardId, N> &cards)
+    {
+        static_assert(N >= 5 && N <= 7, "evaluate<N> handles 5 to 7 cards");
+
+        uint32_t suits[4] = {0, 0, 0, 0};
+        for (size_t i = 0; i < N; ++i)
+            suits[cards[i] / 13] |= 1u << (cards[i] % 13);
+
+        const uint32_t c = suits[0], d = suits[1], h = suits[2], s = suits[3];
+        const uint32_t atLeast1 = c | d | h | s;
+
+        uint32_t flush = 0;
+        if constexpr (N == 5)
+        {
+            // Five cards are a flush only if one suit holds them all
+            if (suits[cards[0] / 13] == atLeast1 && rankCountOf(atLeast1) == 5)
+                flush = atLeast1;
+        }
+        else
+        {
+            for (uint32_t suit : suits)
+                if (rankCountOf(suit) >= 5)
+                    flush = suit;
+        }
+
+        return scoreMasks(atLeast1,
+                          (c & d) | (h & s) | ((c | d) & (h | s)),
+                          (c & d & (h | s)) | (h & s & (c | d)),
+                          c & d & h & s,
+                          flush);
+    }
+
+    /**
+     * Score rank multiplicity masks: bit r of atLeastN is set when rank
+     * r + 2 appears N+ times, `flush` holds the ranks of a five-card suit
+     */
+    static constexpr uint32_t scoreMasks(uint32_t atLeast1, uint32_t atLeast2,
+                                         uint32_t atLeast3, uint32_t atLeast4,
+                                         uint32_t flush)
+    {
+        if (flush)
+        {
+            uint32_t sfHigh = straightHighOf(flush);
+            if (sfHigh == 14)
+                return pack(HandRank::RoyalFlush, 14, 1);
+            if (sfHigh)
+                return pack(HandRank::StraightFlush, sfHigh, 1);
+        }
+
+        if (atLeast4)
+        {
+            uint32_t quad = topRanks(atLeast4, 1);
+            return pack(HandRank::FourOfAKind, (quad << 4) | topRanks(atLeast1 & ~rankBit(quad), 1), 2);
+        }
+
+        uint32_t trip = atLeast3 ? topRanks(atLeast3, 1) : 0;
+        if (trip)
+        {
+            uint32_t pairs = atLeast2 & ~rankBit(trip);
+            if (pairs)
+                return pack(HandRank::FullHouse, (trip << 4) | topRanks(pairs, 1), 2);
+        }
+
+        if (flush)
+            return pack(HandRank::Flush, topRanks(flush, 5), 5);
+
+        if (uint32_t high = straightHighOf(atLeast1))
+            return pack(HandRank::Straight, high, 1);
+
+        if (trip)
+            return pack(HandRank::ThreeOfAKind, (trip << 8) | topRanks(atLeast1 & ~rankBit(trip), 2), 3);
+
+        if (atLeast2)
+        {
+            uint32_t high = topRanks(atLeast2, 1);
+            uint32_t rest = atLeast2 & ~rankBit(high);
+            if (rest)
+            {
+                uint32_t low = topRanks(rest, 1);
+                uint32_t kicker = topRanks(atLeast1 & ~rankBit(high) & ~rankBit(low), 1);
+                return pack(HandRank::TwoPair, (high << 8) | (low << 4) | kicker, 3);
+            }
+            return pack(HandRank::OnePair, (high << 12) | topRanks(atLeast1 & ~rankBit(high), 3), 4);
+        }
+
+        return pack(HandRank::HighCard, topRanks(atLeast1, 5), 5);
+    }
+
+private:
+    static constexpr uint32_t pack(HandRank rank, uint32_t kickers, int count)
+    {
+        return (static_cast<uint32_t>(rank) << HandValue::CATEGORY_SHIFT) |
+               (kickers << (4 * (5 - count)));
+    }
+};
+
+#endif // FIXED_HAND_EVALUATOR_H
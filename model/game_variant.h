@@ -0,0 +1,35 @@
+#ifndef GAME_VARIANT_H
+#define GAME_VARIANT_H
+
+// Poker variants the evaluators and the simulator support
+enum class GameVariant
+{
+    Holdem,     // 2 hole cards, best five of seven
+    Omaha,      // 4 hole cards, exactly two of them with three board cards
+    ShortDeck,  // Hold'em with Twos through Fives removed (36 cards)
+    HoldemHiLo, // Hold'em, pot split with the best 8-or-better low
+    OmahaHiLo   // Omaha, pot split with the best 8-or-better low
+};
+
+inline bool isOmaha(GameVariant variant)
+{
+    return variant == GameVariant::Omaha || variant == GameVariant::OmahaHiLo;
+}
+
+inline bool isHiLo(GameVariant variant)
+{
+    return variant == GameVariant::HoldemHiLo || variant == GameVariant::OmahaHiLo;
+}
+
+inline int holeCardCount(GameVariant variant)
+{
+    return isOmaha(variant) ? 4 : 2;
+}
+
+// Lowest rank value in the deck
+inline int lowestRank(GameVariant variant)
+{
+    return variant == GameVariant::ShortDeck ? 6 : 2;
+}
+
+#endif // GAME_VARIANT_H
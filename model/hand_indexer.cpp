@@ -0,0 +1,325 @@
+// hand_indexer.cpp
+#include "hand_indexer.h"
+#include "combinatorics.h"
+#include <algorithm>
+#include <stdexcept>
+
+/**
+ * C(n, k) for the multiset counts, where n can be far above 52; k is at
+ * most four (one per suit)
+ */
+static uint64_t bigChoose(uint64_t n, int k)
+{
+    if (n < static_cast<uint64_t>(k))
+        return 0;
+    unsigned __int128 result = 1;
+    for (int i = 0; i < k; ++i)
+        result = result * (n - i) / (i + 1);
+    return static_cast<uint64_t>(result);
+}
+
+HandIndexer::HandIndexer(const std::vector<int> &rounds) : roundCount(static_cast<int>(rounds.size()))
+{
+    if (roundCount < 1 || roundCount > MAX_ROUNDS)
+        throw std::invalid_argument("HandIndexer handles 1 to 4 rounds");
+
+    int cards = 0;
+    for (int r = 0; r < roundCount; ++r)
+    {
+        cardsPerRound[r] = rounds[r];
+        cards += rounds[r];
+        if (rounds[r] < 1 || rounds[r] > 13)
+            throw std::invalid_argument("Each round deals 1 to 13 cards");
+    }
+    if (cards > BinomialTable::MAX_K)
+        throw std::invalid_argument("HandIndexer handles at most 7 cards");
+
+    uint16_t keys[4];
+    int left[MAX_ROUNDS];
+    std::copy(cardsPerRound, cardsPerRound + roundCount, left);
+    addConfigurations(0, keys, left);
+}
+
+const HandIndexer &HandIndexer::forBoard(int boardSize)
+{
+    static const HandIndexer preflop({2});
+    static const HandIndexer flop({2, 3});
+    static const HandIndexer turn({2, 4});
+    static const HandIndexer river({2, 5});
+
+    switch (boardSize)
+    {
+    case 0:
+        return preflop;
+    case 3:
+        return flop;
+    case 4:
+        return turn;
+    case 5:
+        return river;
+    default:
+        throw std::invalid_argument("Board must have 0, 3, 4 or 5 cards");
+    }
+}
+
+uint64_t HandIndexer::indexOf(CardSpan hole, CardSpan board)
+{
+    const CardSet rounds[2] = {CardSet::fromCards(hole), CardSet::fromCards(board)};
+    return forBoard(static_cast<int>(board.size())).index(rounds);
+}
+
+int HandIndexer::countIn(uint16_t suitKey, int round) const
+{
+    return (suitKey >> (4 * (roundCount - 1 - round))) & 0xF;
+}
+
+/**
+ * Every sorted (non-increasing) choice of suit keys whose per-round counts
+ * add up to the cards dealt; each becomes one Configuration
+ */
+void HandIndexer::addConfigurations(int suit, uint16_t *keys, int *left)
+{
+    if (suit == 4)
+    {
+        for (int r = 0; r < roundCount; ++r)
+            if (left[r] != 0)
+                return;
+
+        Configuration config = {};
+        config.offset = total;
+        for (int s = 0; s < 4; ++s)
+        {
+            config.key = (config.key << 16) | keys[s];
+            if (s > 0 && keys[s] == keys[s - 1])
+            {
+                config.suits[config.groups - 1]++;
+                continue;
+            }
+            config.suitKey[config.groups] = keys[s];
+            config.suits[config.groups] = 1;
+            config.groups++;
+        }
+
+        uint64_t count = 1;
+        for (int g = 0; g < config.groups; ++g)
+        {
+            config.choices[g] = suitChoices(config.suitKey[g]);
+            config.radix[g] = bigChoose(config.choices[g] + config.suits[g] - 1, config.suits[g]);
+            count *= config.radix[g];
+        }
+        total += count;
+
+        configurationByKey[config.key] = static_cast<int>(configurations.size());
+        configurations.push_back(config);
+        return;
+    }
+
+    // Suit keys are tried from the largest down; a suit may not exceed the one before
+    uint16_t largest = 0;
+    for (int r = 0; r < roundCount; ++r)
+        largest = (largest << 4) | cardsPerRound[r];
+    uint16_t limit = suit == 0 ? largest : keys[suit - 1];
+
+    for (int key = limit; key >= 0; --key)
+    {
+        bool fits = true;
+        int cards = 0;
+        for (int r = 0; r < roundCount && fits; ++r)
+        {
+            int n = countIn(static_cast<uint16_t>(key), r);
+            fits = n <= left[r];
+            cards += n;
+        }
+        if (!fits || cards > 13 || (key >> (4 * roundCount)) != 0)
+            continue;
+
+        keys[suit] = static_cast<uint16_t>(key);
+        for (int r = 0; r < roundCount; ++r)
+            left[r] -= countIn(keys[suit], r);
+        addConfigurations(suit + 1, keys, left);
+        for (int r = 0; r < roundCount; ++r)
+            left[r] += countIn(keys[suit], r);
+    }
+}
+
+// Ways one suit can hold its cards: each round picks from the ranks still free
+uint64_t HandIndexer::suitChoices(uint16_t suitKey) const
+{
+    uint64_t choices = 1;
+    int used = 0;
+    for (int r = 0; r < roundCount; ++r)
+    {
+        int n = countIn(suitKey, r);
+        choices *= choose(13 - used, n);
+        used += n;
+    }
+    return choices;
+}
+
+/**
+ * Mixed-radix index of one suit's rank masks, round 0 least significant;
+ * each round's ranks are colex-ranked among the ranks earlier rounds left
+ */
+uint64_t HandIndexer::suitIndex(const uint32_t *rankMasks, uint16_t suitKey) const
+{
+    uint64_t index = 0;
+    uint64_t scale = 1;
+    uint32_t used = 0;
+    int usedCount = 0;
+    for (int r = 0; r < roundCount; ++r)
+    {
+        uint64_t local = 0;
+        int i = 1;
+        for (uint32_t m = rankMasks[r]; m; m &= m - 1)
+        {
+            int rank = __builtin_ctz(m);
+            int position = rank - __builtin_popcount(used & ((1u << rank) - 1));
+            local += choose(position, i++);
+        }
+
+        int n = countIn(suitKey, r);
+        index += scale * local;
+        scale *= choose(13 - usedCount, n);
+        used |= rankMasks[r];
+        usedCount += n;
+    }
+    return index;
+}
+
+void HandIndexer::suitUnindex(uint64_t index, uint16_t suitKey, uint32_t *rankMasks) const
+{
+    uint32_t used = 0;
+    int usedCount = 0;
+    for (int r = 0; r < roundCount; ++r)
+    {
+        int n = countIn(suitKey, r);
+        int free = 13 - usedCount;
+        uint64_t radix = choose(free, n);
+        uint64_t local = index % radix;
+        index /= radix;
+
+        // Colex unrank over the free positions, then map positions to ranks
+        uint32_t positions = 0;
+        int p = free;
+        for (int i = n; i >= 1; --i)
+        {
+            do
+                --p;
+            while (choose(p, i) > local);
+            positions |= 1u << p;
+            local -= choose(p, i);
+        }
+
+        uint32_t mask = 0;
+        for (int rank = 0, position = 0; rank < 13; ++rank)
+        {
+            if (used & (1u << rank))
+                continue;
+            if (positions & (1u << position))
+                mask |= 1u << rank;
+            position++;
+        }
+
+        rankMasks[r] = mask;
+        used |= mask;
+        usedCount += n;
+    }
+}
+
+uint64_t HandIndexer::index(const CardSet *rounds) const
+{
+    struct Suit
+    {
+        uint16_t key;
+        uint64_t index;
+    };
+    Suit suits[4];
+    for (int s = 0; s < 4; ++s)
+    {
+        uint32_t masks[MAX_ROUNDS];
+        uint16_t key = 0;
+        for (int r = 0; r < roundCount; ++r)
+        {
+            masks[r] = rounds[r].suitMask(s);
+            key = (key << 4) | __builtin_popcount(masks[r]);
+        }
+        suits[s] = {key, suitIndex(masks, key)};
+    }
+
+    // Canonical suit order: configuration first, then suit index, both descending
+    std::sort(suits, suits + 4, [](const Suit &a, const Suit &b) {
+        return a.key != b.key ? a.key > b.key : a.index > b.index;
+    });
+
+    uint64_t key = 0;
+    for (const Suit &suit : suits)
+        key = (key << 16) | suit.key;
+    auto found = configurationByKey.find(key);
+    if (found == configurationByKey.end())
+        throw std::invalid_argument("Hand does not match the indexer's rounds");
+    const Configuration &config = configurations[found->second];
+
+    // Each group's suit indices, ascending, ranked as a multiset
+    uint64_t index = 0;
+    uint64_t scale = 1;
+    int first = 0;
+    for (int g = 0; g < config.groups; ++g)
+    {
+        int n = config.suits[g];
+        uint64_t rank = 0;
+        for (int i = 1; i <= n; ++i)
+            rank += bigChoose(suits[first + n - i].index + i - 1, i);
+
+        index += scale * rank;
+        scale *= config.radix[g];
+        first += n;
+    }
+    return config.offset + index;
+}
+
+void HandIndexer::unindex(uint64_t index, CardSet *rounds) const
+{
+    if (index >= total)
+        throw std::out_of_range("Hand index out of range");
+
+    auto after = std::upper_bound(configurations.begin(), configurations.end(), index,
+                                  [](uint64_t i, const Configuration &c) { return i < c.offset; });
+    const Configuration &config = *(after - 1);
+
+    for (int r = 0; r < roundCount; ++r)
+        rounds[r] = CardSet{};
+
+    uint64_t rest = index - config.offset;
+    int suit = 0;
+    for (int g = 0; g < config.groups; ++g)
+    {
+        int n = config.suits[g];
+        uint64_t rank = rest % config.radix[g];
+        rest /= config.radix[g];
+
+        // Largest value first: undo the multiset rank one element at a time
+        uint64_t values[4];
+        for (int i = n; i >= 1; --i)
+        {
+            uint64_t low = i - 1, high = config.choices[g] + n - 1;
+            while (high - low > 1)
+            {
+                uint64_t mid = low + (high - low) / 2;
+                if (bigChoose(mid, i) <= rank)
+                    low = mid;
+                else
+                    high = mid;
+            }
+            rank -= bigChoose(low, i);
+            values[n - i] = low - (i - 1);
+        }
+
+        for (int j = 0; j < n; ++j, ++suit)
+        {
+            uint32_t masks[MAX_ROUNDS];
+            suitUnindex(values[j], config.suitKey[g], masks);
+            for (int r = 0; r < roundCount; ++r)
+                rounds[r].bits |= uint64_t(masks[r]) << (16 * suit);
+        }
+    }
+}
@@ -0,0 +1,81 @@
+#ifndef HAND_INDEXER_H
+#define HAND_INDEXER_H
+
+#include "card.h"
+#include "card_set.h"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * HandIndexer - perfect index of hands up to a relabeling of suits
+ *
+ * A hand is dealt in rounds (say two hole cards, then the board); two
+ * hands whose suits can be renamed into each other get the same index,
+ * and indices are dense in [0, size()). Rounds stay distinct, so a card
+ * moving from the hole to the board changes the hand. Sizes:
+ *
+ *     {2}           169 preflop hands        {3}  1,755 flops
+ *     {2, 3}  1,286,792 hole + flop
+ *     {2, 4} 13,960,050 hole + turn board
+ *     {2, 5} 123,156,254 hole + river board
+ *
+ * Each suit is described by how many cards it has in each round (its
+ * configuration) and by which ranks they are (an index into that suit's
+ * choices). Suits with the same configuration are interchangeable, so the
+ * hand's index is an offset for the sorted configurations plus the
+ * multiset rank of the suit indices in each group of equal ones; this is
+ * the construction of Waugh's hand isomorphism indexer.
+ * unindex() returns the canonical hand of an index, so
+ * canonicalize() = unindex(index()) picks one fixed suit labelling.
+ */
+class HandIndexer
+{
+public:
+    static constexpr int MAX_ROUNDS = 4;
+
+    // Cards dealt per round, e.g. {2, 3} for hole cards then the flop
+    explicit HandIndexer(const std::vector<int> &cardsPerRound);
+
+    // Hole cards plus a board of 0, 3, 4 or 5 cards, built on first use
+    static const HandIndexer &forBoard(int boardSize);
+
+    uint64_t size() const { return total; }
+    int rounds() const { return roundCount; }
+
+    // One CardSet per round
+    uint64_t index(const CardSet *rounds) const;
+    void unindex(uint64_t index, CardSet *rounds) const;
+    void canonicalize(const CardSet *rounds, CardSet *out) const { unindex(index(rounds), out); }
+
+    // Hole cards and board as played, through forBoard(board.size())
+    static uint64_t indexOf(CardSpan hole, CardSpan board);
+
+private:
+    // One way the four suits can split the rounds' cards, suits sorted
+    struct Configuration
+    {
+        uint64_t key;            // the four suit keys, 16 bits each
+        uint64_t offset;         // first index of this configuration
+        int groups;              // runs of suits with the same suit key
+        uint16_t suitKey[4];     // per group: cards per round, 4 bits each
+        int suits[4];            // per group: how many suits share it
+        uint64_t choices[4];     // per group: rank choices for one suit
+        uint64_t radix[4];       // per group: multisets of `suits` choices
+    };
+
+    int roundCount;
+    int cardsPerRound[MAX_ROUNDS];
+    uint64_t total = 0;
+    std::vector<Configuration> configurations;
+    std::unordered_map<uint64_t, int> configurationByKey;
+
+    void addConfigurations(int suit, uint16_t *keys, int *left);
+    uint64_t suitChoices(uint16_t suitKey) const;
+    uint64_t suitIndex(const uint32_t *rankMasks, uint16_t suitKey) const;
+    void suitUnindex(uint64_t index, uint16_t suitKey, uint32_t *rankMasks) const;
+    int countIn(uint16_t suitKey, int round) const;
+};
+
+#endif // HAND_INDEXER_H
@@ -2,7 +2,7 @@
 #ifndef HAND_TYPES_H
 #define HAND_TYPES_H
 
-#include <vector>
+#include <cstdint>
 
 // enum for hand strength
 enum class HandRank
@@ -20,33 +20,42 @@ enum class HandRank
 };
 
 // structure to store the evaluated hand value
+//
+// The strength is packed into one 32-bit score: the HandRank in bits 20-23
+// and up to five kickers (rank values 2-14) in the nibbles below, most
+// significant first. One integer comparison orders two hands. Variants that
+// reorder the categories (short deck) put the category's position in their
+// order in bits 24-27, above the HandRank.
 struct HandValue
 {
-    HandRank rank;
-    std::vector<int> kickers; // for tiebreakers
+    static constexpr int CATEGORY_SHIFT = 20;
+    static constexpr int ORDER_SHIFT = 24;
 
-    bool operator>(const HandValue &other) const;
-    bool operator==(const HandValue &other) const;
-};
+    HandRank rank;      // category, mirrors bits 20-23 of the score
+    uint32_t score = 0; // packed strength
 
-// Implementation of operators
-inline bool HandValue::operator>(const HandValue &other) const
-{
-    if (rank != other.rank)
-        return static_cast<int>(rank) > static_cast<int>(other.rank);
+    static constexpr HandValue fromScore(uint32_t score)
+    {
+        return HandValue{static_cast<HandRank>((score >> CATEGORY_SHIFT) & 0xF), score};
+    }
 
-    // Compare kickers
-    for (size_t i = 0; i < kickers.size() && i < other.kickers.size(); ++i)
+    // Number of meaningful kickers for this rank (e.g. 2 for Full House)
+    int kickerCount() const
     {
-        if (kickers[i] != other.kickers[i])
-            return kickers[i] > other.kickers[i];
+        static const int KICKER_COUNT[] = {5, 4, 3, 3, 1, 5, 2, 2, 1, 1};
+        return KICKER_COUNT[static_cast<int>(rank)];
     }
-    return false; // Tie
-}
 
-inline bool HandValue::operator==(const HandValue &other) const
-{
-    return rank == other.rank && kickers == other.kickers;
-}
+    // i-th tiebreaker, 0 past kickerCount()
+    constexpr int kicker(int i) const
+    {
+        return static_cast<int>((score >> (16 - 4 * i)) & 0xF);
+    }
+
+    bool operator>(const HandValue &other) const { return score > other.score; }
+    bool operator<(const HandValue &other) const { return score < other.score; }
+    bool operator==(const HandValue &other) const { return score == other.score; }
+    bool operator!=(const HandValue &other) const { return score != other.score; }
+};
 
-#endif // HAND_TYPES_H
\ No newline at end of file
+#endif // HAND_TYPES_H
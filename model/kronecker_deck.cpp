@@ -0,0 +1,66 @@
+#include "kronecker_deck.h"
+#include <cmath>
+#include <stdexcept>
+
+KroneckerDeck::KroneckerDeck(GameVariant variant, CardSet dead, int dimensions) : dimensions(dimensions)
+{
+    if (dimensions < 1 || dimensions > MAX_DIMENSIONS)
+    {
+        throw std::invalid_argument("KroneckerDeck needs 1 to 52 dimensions");
+    }
+
+    for (CardId id : CardSet::fullDeck(lowestRank(variant)).without(dead))
+        order[liveCount++] = id;
+    remaining = 0;
+
+    // Newton's method for phi_d, the root of x^(d+1) = x + 1 above 1
+    double phi = 2.0;
+    for (int i = 0; i < 64; ++i)
+        phi -= (std::pow(phi, dimensions + 1) - phi - 1.0) / ((dimensions + 1) * std::pow(phi, dimensions) - 1.0);
+
+    double power = 1.0;
+    for (int k = 0; k < dimensions; ++k)
+    {
+        power /= phi;
+        alpha[k] = static_cast<uint64_t>(std::ldexp(power, 64));
+    }
+}
+
+void KroneckerDeck::start(const uint64_t *shift, uint64_t first)
+{
+    // One step before point `first`, so the first reset() lands on it
+    for (int k = 0; k < dimensions; ++k)
+        point[k] = (first - 1) * alpha[k] + shift[k];
+    remaining = 0;
+}
+
+void KroneckerDeck::reset()
+{
+    for (int k = 0; k < dimensions; ++k)
+        point[k] += alpha[k];
+    cards = order;
+    remaining = liveCount;
+    next = 0;
+}
+
+CardId KroneckerDeck::dealId()
+{
+    if (next == dimensions || remaining == 0)
+    {
+        throw std::out_of_range("KroneckerDeck dealt more cards than its point has coordinates");
+    }
+
+    // The top 32 bits of the coordinate scaled to the cards left
+    const uint64_t at = ((point[next++] >> 32) * static_cast<uint64_t>(remaining)) >> 32;
+    const CardId id = cards[at];
+    cards[at] = cards[--remaining];
+    return id;
+}
+
+CardSet KroneckerDeck::deal(int count)
+{
+    CardSet dealt;
+    for (int i = 0; i < count; ++i)
+        dealt.add(dealId());
+    return dealt;
+}
@@ -0,0 +1,60 @@
+#ifndef KRONECKER_DECK_H
+#define KRONECKER_DECK_H
+
+#include "card.h"
+#include "card_set.h"
+#include "game_variant.h"
+#include <array>
+#include <cstdint>
+
+/**
+ * KroneckerDeck - deals from the points of a randomly shifted Kronecker
+ * sequence
+ *
+ * The quasi-Monte Carlo counterpart of Deck, with the same reset() and
+ * deal calls. Each reset() starts the deal of the next sequence point
+ * x_i = frac(i * alpha + shift) in [0,1)^d, and the k-th card dealt takes
+ * coordinate k: it is the card at floor(x_ik * remaining) among those not
+ * yet dealt, which begin every deal in the same order. Consecutive points
+ * spread over the d-card deals far more evenly than independent draws,
+ * and the random shift still makes each deal uniform, so averages over
+ * several shifts (replicates) are unbiased and their spread is the error.
+ *
+ * alpha_k = phi_d^-k, where phi_d is the root of x^(d+1) = x + 1 (the
+ * generalized golden ratio): the R_d sequence. The alphas are irrational,
+ * so this is an open sequence rather than a rank-1 lattice, which would
+ * use i * z / n for a fixed point count n; any prefix is evenly spread,
+ * so runs need not be sized in advance. Coordinates are 64-bit fixed
+ * point, so the wraparound of the multiply-add is the fractional part.
+ */
+class KroneckerDeck
+{
+public:
+    static constexpr int MAX_DIMENSIONS = 52;
+
+    // The variant's deck without `dead`, dealing `dimensions` cards a point
+    KroneckerDeck(GameVariant variant, CardSet dead, int dimensions);
+
+    // Deal from a replicate's shift (one word per dimension), starting at
+    // point `first`
+    void start(const uint64_t *shift, uint64_t first);
+
+    void reset();            // Puts every card back and moves to the next point
+    CardId dealId();         // Deals one card as a CardId
+    CardSet deal(int count); // Deals `count` cards as a set
+    int size() const { return remaining; }
+
+    int getDimensions() const { return dimensions; }
+
+private:
+    std::array<CardId, 52> order; // live cards in the order every deal starts from
+    std::array<CardId, 52> cards;
+    int liveCount = 0;
+    int remaining = 0;
+    int dimensions;
+    int next = 0;                 // coordinate of the next card dealt
+    uint64_t alpha[MAX_DIMENSIONS];
+    uint64_t point[MAX_DIMENSIONS] = {}; // coordinates of the point being dealt
+};
+
+#endif // KRONECKER_DECK_H
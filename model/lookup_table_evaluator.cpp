@@ -0,0 +1,97 @@
+// lookup_table_evaluator.cpp
+#include "lookup_table_evaluator.h"
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+constexpr char LookupTableEvaluator::MAGIC[8];
+
+const uint32_t *LookupTableEvaluator::table = nullptr;
+size_t LookupTableEvaluator::mappedBytes = 0;
+void *LookupTableEvaluator::mapping = nullptr;
+
+std::string LookupTableEvaluator::defaultPath()
+{
+    const char *env = std::getenv("POKER_HAND_TABLE");
+    return (env && *env) ? env : "hand_ranks.dat";
+}
+
+bool LookupTableEvaluator::load(const std::string &path)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(FileHeader)))
+    {
+        close(fd);
+        return false;
+    }
+
+    size_t bytes = static_cast<size_t>(info.st_size);
+    void *map = mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd); // the mapping keeps the file alive
+    if (map == MAP_FAILED)
+        return false;
+
+    // Reject files from another generator version or a truncated write
+    const FileHeader *header = static_cast<const FileHeader *>(map);
+    bool valid = std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) == 0 &&
+                 header->version == TABLE_VERSION &&
+                 header->entryCount > START_STATE + STATE_SIZE &&
+                 bytes == sizeof(FileHeader) + header->entryCount * sizeof(uint32_t);
+    if (!valid)
+    {
+        munmap(map, bytes);
+        return false;
+    }
+
+    unload();
+    mapping = map;
+    mappedBytes = bytes;
+    table = reinterpret_cast<const uint32_t *>(static_cast<const char *>(map) + sizeof(FileHeader));
+    return true;
+}
+
+void LookupTableEvaluator::unload()
+{
+    if (mapping)
+        munmap(mapping, mappedBytes);
+    mapping = nullptr;
+    mappedBytes = 0;
+    table = nullptr;
+}
+
+bool LookupTableEvaluator::isLoaded()
+{
+    return table != nullptr;
+}
+
+uint32_t LookupTableEvaluator::evaluate(const CardId *cards, size_t count)
+{
+    uint32_t state = START_STATE;
+    for (size_t i = 0; i < count; ++i)
+        state = table[state + cards[i] + 1];
+
+    // A 7th card lands on the score itself; shorter hands read slot 0
+    return count == 7 ? state : table[state];
+}
+
+uint32_t LookupTableEvaluator::evaluate(CardSpan cards)
+{
+    if (cards.size() < 5 || cards.size() > 7)
+    {
+        throw std::invalid_argument("The lookup table evaluates 5 to 7 cards");
+    }
+
+    CardId ids[7];
+    const size_t count = cards.size();
+    for (size_t i = 0; i < count; ++i)
+        ids[i] = toCardId(cards[i]);
+    return evaluate(ids, count);
+}
@@ -0,0 +1,58 @@
+#ifndef LOOKUP_TABLE_EVALUATOR_H
+#define LOOKUP_TABLE_EVALUATOR_H
+
+#include "card.h"
+#include "card_set.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Precomputed state-transition evaluator ("Two Plus Two" style)
+ *
+ * The table is a flat array of uint32_t. Starting from START_STATE, each
+ * card moves to the next state with one lookup:
+ *     state = table[state + card]          (card = CardId + 1, 1..52)
+ * After the 7th card the value read is the packed HandValue score. After 5 or 6 cards, table[state] holds the score of that hand.
+ *
+ * The file is produced by `make hand_table` (tools/generate_hand_table.cpp)
+ * and mapped read-only, so every process on a machine shares one copy.
+ */
+class LookupTableEvaluator
+{
+public:
+    static constexpr uint32_t TABLE_VERSION = 1;
+    static constexpr uint32_t STATE_SIZE = 53; // slot 0 + one per card
+    static constexpr uint32_t START_STATE = STATE_SIZE;
+    static constexpr char MAGIC[8] = {'P', 'K', 'H', 'R', 'T', 'B', 'L', '\0'};
+
+    // On-disk header, followed by `entryCount` uint32_t entries
+    struct FileHeader
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t reserved;
+        uint64_t entryCount;
+    };
+
+    // Default file name, overridable with the POKER_HAND_TABLE environment variable
+    static std::string defaultPath();
+
+    // Map a table file; on error returns false and keeps any table already loaded
+    static bool load(const std::string &path);
+    static void unload();
+    static bool isLoaded();
+
+    // Requires isLoaded() and 5 to 7 distinct cards; the CardSpan overload
+    // throws std::invalid_argument for any other count
+    static uint32_t evaluate(CardSpan cards);
+    static uint32_t evaluate(const CardId *cards, size_t count);
+
+private:
+    static const uint32_t *table;
+    static size_t mappedBytes;
+    static void *mapping;
+};
+
+#endif // LOOKUP_TABLE_EVALUATOR_H
@@ -0,0 +1,105 @@
+// low_hand_evaluator.cpp
+#include "low_hand_evaluator.h"
+#include "bitmask_hand_evaluator.h"
+#include <stdexcept>
+
+// 0x100000 minus the five low cards as nibbles, highest first
+static const uint32_t LOW_BASE = 0x100000;
+
+struct LowTable
+{
+    uint32_t score[256];
+
+    LowTable() : score()
+    {
+        for (uint32_t mask = 0; mask < 256; ++mask)
+        {
+            if (__builtin_popcount(mask) < 5)
+                continue;
+
+            // Lowest five ranks, collected low to high, packed high first
+            uint32_t nibbles = 0;
+            int taken = 0;
+            for (int bit = 0; bit < 8 && taken < 5; ++bit)
+            {
+                if (mask & (1u << bit))
+                {
+                    nibbles |= static_cast<uint32_t>(bit + 1) << (4 * taken);
+                    taken++;
+                }
+            }
+            score[mask] = LOW_BASE - nibbles;
+        }
+    }
+};
+
+static const LowTable &lowTable()
+{
+    static const LowTable table;
+    return table;
+}
+
+uint8_t LowHandEvaluator::lowMask(uint32_t rankMask13)
+{
+    // Twos through Eights are bits 0-6 of a rank mask, the Ace is bit 12
+    return static_cast<uint8_t>(((rankMask13 & 0x7F) << 1) | ((rankMask13 >> 12) & 1));
+}
+
+uint8_t LowHandEvaluator::lowMask(CardSet cards)
+{
+    return lowMask(cards.suitMask(0) | cards.suitMask(1) | cards.suitMask(2) | cards.suitMask(3));
+}
+
+uint32_t LowHandEvaluator::evaluateMask(uint8_t lowRanks)
+{
+    return lowTable().score[lowRanks];
+}
+
+uint32_t LowHandEvaluator::evaluate(CardSet cards)
+{
+    return evaluateMask(lowMask(cards));
+}
+
+std::vector<int> LowHandEvaluator::lowCards(uint32_t lowScore)
+{
+    std::vector<int> cards;
+    if (lowScore == NO_LOW)
+        return cards;
+
+    uint32_t nibbles = LOW_BASE - lowScore;
+    for (int i = 4; i >= 0; --i)
+        cards.push_back(static_cast<int>((nibbles >> (4 * i)) & 0xF));
+    return cards;
+}
+
+HiLoScore LowHandEvaluator::evaluateHiLo(CardSet cards)
+{
+    const uint32_t c = cards.suitMask(0);
+    const uint32_t d = cards.suitMask(1);
+    const uint32_t h = cards.suitMask(2);
+    const uint32_t s = cards.suitMask(3);
+    const uint32_t ranks = c | d | h | s;
+
+    uint32_t flush = 0;
+    for (uint32_t suit : {c, d, h, s})
+        if (__builtin_popcount(suit) >= 5)
+            flush = suit;
+
+    HiLoScore result;
+    result.high = BitmaskHandEvaluator::evaluateMasks(ranks,
+                                                      (c & d) | (h & s) | ((c | d) & (h | s)),
+                                                      (c & d & (h | s)) | (h & s & (c | d)),
+                                                      c & d & h & s,
+                                                      flush);
+    result.low = evaluateMask(lowMask(ranks));
+    return result;
+}
+
+HiLoScore LowHandEvaluator::evaluateHiLo(CardSpan cards)
+{
+    if (cards.size() < 5)
+    {
+        throw std::invalid_argument("At least 5 cards are required for hand evaluation");
+    }
+    return evaluateHiLo(CardSet::fromCards(cards));
+}
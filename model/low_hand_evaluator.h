@@ -0,0 +1,50 @@
+#ifndef LOW_HAND_EVALUATOR_H
+#define LOW_HAND_EVALUATOR_H
+
+#include "card.h"
+#include "card_set.h"
+#include <cstdint>
+#include <vector>
+
+// High and low halves of one Hi/Lo hand
+struct HiLoScore
+{
+    uint32_t high; // packed HandValue score
+    uint32_t low;  // LowHandEvaluator::NO_LOW if the hand has no qualifying low
+};
+
+/**
+ * 8-or-better low hands for Hi/Lo split games
+ *
+ * Only Ace through Eight count, the Ace low, so the ranks a hand can use
+ * for its low fit an 8-bit mask: bit 0 = Ace, bit 1 = Two ... bit 7 =
+ * Eight. Pairs never help a low, so the mask alone decides it: a hand
+ * qualifies with five distinct low ranks and plays the lowest five. The
+ * 256 answers are precomputed.
+ *
+ * Low scores grow as the low gets better (5-4-3-2-A is the best) and are
+ * NO_LOW when the hand does not qualify, so lows compare like high scores.
+ */
+class LowHandEvaluator
+{
+public:
+    static constexpr uint32_t NO_LOW = 0;
+
+    // Low rank mask of a set of cards (ranks from any suit)
+    static uint8_t lowMask(uint32_t rankMask13);
+    static uint8_t lowMask(CardSet cards);
+
+    // Score of the best low within an 8-bit mask, NO_LOW below five ranks
+    static uint32_t evaluateMask(uint8_t lowRanks);
+    static uint32_t evaluate(CardSet cards);
+
+    // The five low cards as values 1 (Ace) to 8, highest first; empty for NO_LOW
+    static std::vector<int> lowCards(uint32_t lowScore);
+
+    // High and low from one pass: the suit masks built for the high hand
+    // also give the ranks for the low
+    static HiLoScore evaluateHiLo(CardSet cards);
+    static HiLoScore evaluateHiLo(CardSpan cards);
+};
+
+#endif // LOW_HAND_EVALUATOR_H
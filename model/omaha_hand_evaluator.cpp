@@ -0,0 +1,189 @@
+// omaha_hand_evaluator.cpp
+#include "omaha_hand_evaluator.h"
+#include "bitmask_hand_evaluator.h"
+#include <initializer_list>
+#include <stdexcept>
+
+/**
+ * Per-rank keys (Two first) whose sums over any five cards with at most
+ * four of a rank are all distinct; found by a greedy search, each key the
+ * smallest value keeping the sums unique.
+ */
+static const uint32_t RANK_KEY[13] = {0, 1, 5, 22, 94, 312, 992, 2422, 5624, 12522, 19998, 43258, 79415};
+static const uint32_t MAX_KEY_SUM = 4 * 79415 + 43258;
+
+struct OmahaTables
+{
+    std::vector<uint32_t> unsuited; // key sum -> score of a hand with no flush
+    uint32_t flush[8192];           // rank mask of a 5-card flush -> score
+
+    OmahaTables() : unsuited(MAX_KEY_SUM + 1, 0)
+    {
+        int counts[13] = {};
+        fillUnsuited(0, 5, counts);
+
+        for (uint32_t mask = 0; mask < 8192; ++mask)
+            flush[mask] = __builtin_popcount(mask) == 5
+                              ? BitmaskHandEvaluator::evaluateMasks(mask, 0, 0, 0, mask)
+                              : 0;
+    }
+
+    // Every rank multiset of `left` more cards, ranks from `from` upwards
+    void fillUnsuited(int from, int left, int *counts)
+    {
+        if (left == 0)
+        {
+            uint32_t atLeast[4] = {0, 0, 0, 0};
+            uint32_t key = 0;
+            for (int r = 0; r < 13; ++r)
+            {
+                for (int n = 0; n < counts[r]; ++n)
+                    atLeast[n] |= 1u << r;
+                key += counts[r] * RANK_KEY[r];
+            }
+            unsuited[key] = BitmaskHandEvaluator::evaluateMasks(atLeast[0], atLeast[1], atLeast[2], atLeast[3], 0);
+            return;
+        }
+        for (int r = from; r < 13; ++r)
+        {
+            if (counts[r] == 4)
+                continue;
+            counts[r]++;
+            fillUnsuited(r, left - 1, counts);
+            counts[r]--;
+        }
+    }
+};
+
+static const OmahaTables &tables()
+{
+    static const OmahaTables instance;
+    return instance;
+}
+
+/**
+ * Low-rank mask of cards that are all distinct lows (Ace to Eight), else 0
+ */
+static uint8_t distinctLows(std::initializer_list<CardId> cards, int expected)
+{
+    uint32_t ranks = 0;
+    for (CardId id : cards)
+        ranks |= 1u << (id % 13);
+    uint8_t lows = LowHandEvaluator::lowMask(ranks);
+    return __builtin_popcount(lows) == expected ? lows : 0;
+}
+
+OmahaHandEvaluator::Board OmahaHandEvaluator::Board::of(const CardId *cards, size_t n)
+{
+    Board board;
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = i + 1; j < n; ++j)
+            for (size_t k = j + 1; k < n; ++k)
+            {
+                int suit = cards[i] / 13;
+                bool suited = cards[j] / 13 == suit && cards[k] / 13 == suit;
+                board.tripleKey[board.count] = RANK_KEY[cards[i] % 13] + RANK_KEY[cards[j] % 13] +
+                                               RANK_KEY[cards[k] % 13];
+                board.tripleRanks[board.count] = static_cast<uint16_t>(
+                    (1u << (cards[i] % 13)) | (1u << (cards[j] % 13)) | (1u << (cards[k] % 13)));
+                board.tripleSuit[board.count] = static_cast<int8_t>(suited ? suit : -1);
+                board.tripleLow[board.count] = distinctLows({cards[i], cards[j], cards[k]}, 3);
+                board.count++;
+            }
+    return board;
+}
+
+OmahaHandEvaluator::Board OmahaHandEvaluator::Board::of(CardSpan cards)
+{
+    CardId ids[5];
+    size_t n = cards.size() < 5 ? cards.size() : 5;
+    for (size_t i = 0; i < n; ++i)
+        ids[i] = toCardId(cards[i]);
+    return of(ids, n);
+}
+
+uint32_t OmahaHandEvaluator::evaluate(const Board &board, const CardId hole[HOLE_CARDS])
+{
+    const OmahaTables &t = tables();
+    const uint32_t *unsuited = t.unsuited.data();
+
+    // The six hole pairs; a pair's suit is -2 when it is offsuit so it
+    // never matches a triple's -1
+    uint32_t pairKey[6];
+    uint32_t pairRanks[6];
+    int pairSuit[6];
+    int p = 0;
+    for (int i = 0; i < HOLE_CARDS; ++i)
+        for (int j = i + 1; j < HOLE_CARDS; ++j, ++p)
+        {
+            pairKey[p] = RANK_KEY[hole[i] % 13] + RANK_KEY[hole[j] % 13];
+            pairRanks[p] = (1u << (hole[i] % 13)) | (1u << (hole[j] % 13));
+            pairSuit[p] = hole[i] / 13 == hole[j] / 13 ? hole[i] / 13 : -2;
+        }
+
+    uint32_t best = 0;
+    for (int tr = 0; tr < board.count; ++tr)
+    {
+        for (p = 0; p < 6; ++p)
+        {
+            uint32_t score = board.tripleSuit[tr] == pairSuit[p]
+                                 ? t.flush[board.tripleRanks[tr] | pairRanks[p]]
+                                 : unsuited[board.tripleKey[tr] + pairKey[p]];
+            if (score > best)
+                best = score;
+        }
+    }
+    return best;
+}
+
+HiLoScore OmahaHandEvaluator::evaluateHiLo(const Board &board, const CardId hole[HOLE_CARDS])
+{
+    uint8_t pairLow[6];
+    int p = 0;
+    for (int i = 0; i < HOLE_CARDS; ++i)
+        for (int j = i + 1; j < HOLE_CARDS; ++j, ++p)
+            pairLow[p] = distinctLows({hole[i], hole[j]}, 2);
+
+    // A low needs a triple and a pair of distinct lows sharing no rank
+    uint32_t low = LowHandEvaluator::NO_LOW;
+    for (int t = 0; t < board.count; ++t)
+    {
+        if (!board.tripleLow[t])
+            continue;
+        for (p = 0; p < 6; ++p)
+        {
+            if (pairLow[p] && !(pairLow[p] & board.tripleLow[t]))
+            {
+                uint32_t score = LowHandEvaluator::evaluateMask(pairLow[p] | board.tripleLow[t]);
+                if (score > low)
+                    low = score;
+            }
+        }
+    }
+    return HiLoScore{evaluate(board, hole), low};
+}
+
+// Hole cards as CardIds, after checking the hand shape
+static void holeIdsOf(CardSpan hole, CardSpan board, CardId *ids)
+{
+    if (hole.size() != OmahaHandEvaluator::HOLE_CARDS || board.size() < 3 || board.size() > 5)
+    {
+        throw std::invalid_argument("Omaha needs 4 hole cards and 3 to 5 board cards");
+    }
+    for (int i = 0; i < OmahaHandEvaluator::HOLE_CARDS; ++i)
+        ids[i] = toCardId(hole[i]);
+}
+
+HandValue OmahaHandEvaluator::evaluate(CardSpan hole, CardSpan board)
+{
+    CardId holeIds[HOLE_CARDS];
+    holeIdsOf(hole, board, holeIds);
+    return HandValue::fromScore(evaluate(Board::of(board), holeIds));
+}
+
+HiLoScore OmahaHandEvaluator::evaluateHiLo(CardSpan hole, CardSpan board)
+{
+    CardId holeIds[HOLE_CARDS];
+    holeIdsOf(hole, board, holeIds);
+    return evaluateHiLo(Board::of(board), holeIds);
+}
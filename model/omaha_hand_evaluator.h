@@ -0,0 +1,54 @@
+#ifndef OMAHA_HAND_EVALUATOR_H
+#define OMAHA_HAND_EVALUATOR_H
+
+#include "card.h"
+#include "card_set.h"
+#include "hand_types.h"
+#include "low_hand_evaluator.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Omaha evaluator: exactly two of the four hole cards plus three board cards
+ *
+ * Every candidate hand is exactly five cards, so it is scored with one of
+ * two small tables instead of a general evaluator:
+ *   - unsuited hands by the sum of per-rank keys, which is unique for
+ *     every 5-card rank multiset (max sum 360,918);
+ *   - flushes by the 13-bit rank mask of the suit.
+ * The board's 3-card subsets and their key sums are split out once into a
+ * Board and shared by every hole hand evaluated against it, so each of the
+ * 60 candidates costs an add, a compare and a load.
+ */
+class OmahaHandEvaluator
+{
+public:
+    static constexpr int HOLE_CARDS = 4;
+
+    struct Board
+    {
+        uint32_t tripleKey[10];   // sum of the three rank keys
+        uint16_t tripleRanks[10]; // rank mask, used when the triple is suited
+        int8_t tripleSuit[10];    // suit of a single-suited triple, -1 otherwise
+        uint8_t tripleLow[10];    // low ranks of a triple of three distinct lows, else 0
+        int count = 0;
+
+        // 3 to 5 board cards
+        static Board of(const CardId *cards, size_t n);
+        static Board of(CardSpan cards);
+    };
+
+    // Packed HandValue score of the best legal hand
+    static uint32_t evaluate(const Board &board, const CardId hole[HOLE_CARDS]);
+
+    // Throws unless there are 4 hole cards and 3 to 5 board cards
+    static HandValue evaluate(CardSpan hole, CardSpan board);
+
+    // Omaha Hi/Lo: the high hand and the best 8-or-better low in one pass;
+    // the low also uses exactly two hole cards, possibly not the high's two
+    static HiLoScore evaluateHiLo(const Board &board, const CardId hole[HOLE_CARDS]);
+    static HiLoScore evaluateHiLo(CardSpan hole, CardSpan board);
+};
+
+#endif // OMAHA_HAND_EVALUATOR_H
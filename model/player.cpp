@@ -97,7 +97,7 @@ void Player::showHand(bool showCards) const
 	std::cout << std::endl;
 }
 
-std::vector<Card> Player::getHand() const
+const HoleCards &Player::getHand() const
 {
 	return hand;
 }
\ No newline at end of file
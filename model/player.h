@@ -2,7 +2,7 @@
 #define PLAYER_H
 
 #include "card.h"
-#include <vector>
+#include "card_list.h"
 #include <string>
 
 /**
@@ -17,7 +17,7 @@ class Player
 {
 private:
 	std::string name;
-	std::vector<Card> hand;
+	HoleCards hand;
 	int chips;
 	bool folded;
 
@@ -35,7 +35,7 @@ public:
 	bool isFolded() const;
 	int getChipCount() const;
 	std::string getName() const;
-	std::vector<Card> getHand() const;
+	const HoleCards &getHand() const;
 
 	void showHand(bool showCards = true) const; // Print cards (face down if false)
 };
@@ -80,6 +80,48 @@ inline double calculatePotOddsPercentage(int potSize, int callAmount) {
     return static_cast<double>(callAmount) / (potSize + callAmount);
 }
 
+/**
+ * Two-sided z-score of a confidence level: a normal estimate lies within
+ * ±z standard deviations of its mean with that probability (0.95 -> 1.96)
+ *
+ * Solved by Newton's method on the upper tail, which is convex above 0,
+ * so the iterates climb to the root without overshooting.
+ */
+inline double zScore(double confidence) {
+    confidence = std::clamp(confidence, 0.0, 1.0 - 1e-15);
+    double tail = (1.0 - confidence) / 2.0;  // probability above +z
+    double z = 0.0;
+    for (int i = 0; i < 100; ++i) {
+        double excess = 0.5 * std::erfc(z / std::sqrt(2.0)) - tail;
+        double density = 0.3989422804014327 * std::exp(-0.5 * z * z);  // 1/sqrt(2*pi)
+        double step = excess / density;
+        z += step;
+        if (step < 1e-12) break;
+    }
+    return z;
+}
+
+/**
+ * Half-width of a win-rate interval at `z` after `trials` showdowns with
+ * `wins` wins, worth `effectiveTrials` plain ones. The spread uses the
+ * rate shrunk towards 1/2 by two wins and two losses, so a run of all
+ * wins or all losses is not mistaken for a certain result.
+ */
+inline double winRateMargin(double wins, double trials, double effectiveTrials, double z) {
+    double shrunk = (wins + 2.0) / (trials + 4.0);
+    return z * std::sqrt(shrunk * (1.0 - shrunk) / effectiveTrials);
+}
+
+/**
+ * Sequential stopping test: true once winRate ± margin is within
+ * ±halfWidth, or lies wholly above or below `threshold` (negative for
+ * none)
+ */
+inline bool intervalSettled(double winRate, double margin, double halfWidth, double threshold) {
+    if (margin <= halfWidth) return true;
+    return threshold >= 0.0 && (winRate - margin > threshold || winRate + margin < threshold);
+}
+
 /**
  * Calculate implied odds
  * Considers future betting rounds
@@ -0,0 +1,74 @@
+#ifndef RANK_TABLES_H
+#define RANK_TABLES_H
+
+#include <cstdint>
+
+/**
+ * Compile-time tables over 13-bit rank masks (bit 0 = Two, bit 12 = Ace)
+ *
+ * RANK_TABLES.info[mask] packs everything the evaluators ask of a mask:
+ *   bits  0-19  the five highest ranks as kicker nibbles (highest in 16-19)
+ *   bits 20-23  high card of the best straight, 0 if none
+ *   bits 24-27  number of ranks in the mask
+ * The table is built by the compiler, so there is no startup cost and it
+ * lives in read-only data.
+ */
+struct RankTables
+{
+    static constexpr uint32_t MASKS = 8192;
+
+    uint32_t info[MASKS];
+
+    constexpr RankTables() : info()
+    {
+        for (uint32_t mask = 0; mask < MASKS; ++mask)
+        {
+            uint32_t top = 0;
+            uint32_t count = 0;
+            for (int r = 12; r >= 0; --r)
+            {
+                if (!(mask & (1u << r)))
+                    continue;
+                if (count < 5)
+                    top |= static_cast<uint32_t>(r + 2) << (16 - 4 * count);
+                count++;
+            }
+
+            // Shift up by one so the Ace can also sit below the Two
+            uint32_t m = (mask << 1) | ((mask >> 12) & 1);
+            uint32_t runs = m & (m << 1) & (m << 2) & (m << 3) & (m << 4);
+            uint32_t straight = 0;
+            for (int b = 13; b >= 4 && !straight; --b)
+                if (runs & (1u << b))
+                    straight = b + 1;
+
+            info[mask] = top | (straight << 20) | (count << 24);
+        }
+    }
+};
+
+inline constexpr RankTables RANK_TABLES{};
+
+// Highest `count` ranks of a mask as right-aligned nibbles (count 1..5)
+constexpr uint32_t topRanks(uint32_t mask, int count)
+{
+    return (RANK_TABLES.info[mask] & 0xFFFFF) >> (4 * (5 - count));
+}
+
+constexpr uint32_t straightHighOf(uint32_t mask)
+{
+    return (RANK_TABLES.info[mask] >> 20) & 0xF;
+}
+
+constexpr uint32_t rankCountOf(uint32_t mask)
+{
+    return RANK_TABLES.info[mask] >> 24;
+}
+
+// Rank value (2-14) -> its bit in a rank mask
+constexpr uint32_t rankBit(uint32_t rank)
+{
+    return 1u << (rank - 2);
+}
+
+#endif // RANK_TABLES_H
@@ -0,0 +1,59 @@
+// rng.cpp
+#include "rng.h"
+#include <cstdlib>
+#include <mutex>
+#include <random>
+
+void Rng::jump()
+{
+    static const uint64_t JUMP[4] = {0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull,
+                                     0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull};
+
+    uint64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    for (uint64_t word : JUMP)
+    {
+        for (int b = 0; b < 64; ++b)
+        {
+            if (word & (uint64_t(1) << b))
+            {
+                s0 ^= state[0];
+                s1 ^= state[1];
+                s2 ^= state[2];
+                s3 ^= state[3];
+            }
+            (*this)();
+        }
+    }
+    state[0] = s0;
+    state[1] = s1;
+    state[2] = s2;
+    state[3] = s3;
+}
+
+Rng Rng::stream(uint64_t seed, unsigned index)
+{
+    Rng rng(seed);
+    for (unsigned i = 0; i < index; ++i)
+        rng.jump();
+    return rng;
+}
+
+uint64_t Rng::processSeed()
+{
+    static const uint64_t seed = [] {
+        if (const char *value = std::getenv("POKER_SEED"))
+            return static_cast<uint64_t>(std::strtoull(value, nullptr, 0));
+        std::random_device device;
+        return (static_cast<uint64_t>(device()) << 32) | device();
+    }();
+    return seed;
+}
+
+Rng Rng::nextStream()
+{
+    static std::mutex lock;
+    static Rng master(processSeed());
+
+    std::lock_guard<std::mutex> guard(lock);
+    return master.split();
+}
@@ -0,0 +1,160 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Rng - xoshiro256** random number generator with jump-ahead streams
+ *
+ * Four words of state, a handful of shifts and rotates per 64-bit output,
+ * and it satisfies UniformRandomBitGenerator so the <random> distributions
+ * and std::shuffle accept it. jump() advances the state by 2^128 outputs,
+ * which splits one seed into non-overlapping streams:
+ *
+ *     Rng master(seed);
+ *     Rng a = master.split(); // a starts here, master moves 2^128 ahead
+ *     Rng b = master.split();
+ *
+ * Every Rng in the program should come from nextStream(), which splits a
+ * process-wide master seeded from POKER_SEED (or random_device if unset),
+ * so a run can be repeated exactly by setting the same seed.
+ */
+class Rng
+{
+public:
+    using result_type = uint64_t;
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT64_MAX; }
+
+    // The state is expanded from the seed with SplitMix64, as recommended
+    explicit Rng(uint64_t seed = 0)
+    {
+        for (uint64_t &word : state)
+        {
+            seed += 0x9E3779B97F4A7C15ull;
+            uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    result_type operator()()
+    {
+        const uint64_t result = rotl(state[1] * 5, 7) * 9;
+        const uint64_t t = state[1] << 17;
+
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45);
+
+        return result;
+    }
+
+    /**
+     * Uniform in [0, n): Lemire's multiply-shift reduction with rejection,
+     * exact and almost never more than one draw
+     */
+    uint32_t below(uint32_t n)
+    {
+        uint64_t product = (*this)() >> 32;
+        product *= n;
+        uint32_t low = static_cast<uint32_t>(product);
+        if (low < n)
+        {
+            const uint32_t threshold = -n % n;
+            while (low < threshold)
+            {
+                product = ((*this)() >> 32) * n;
+                low = static_cast<uint32_t>(product);
+            }
+        }
+        return static_cast<uint32_t>(product >> 32);
+    }
+
+    // Uniform in [0, 1) with 53 random bits
+    double uniform() { return ((*this)() >> 11) * 0x1.0p-53; }
+
+    // Advance by 2^128 outputs
+    void jump();
+
+    // A stream starting here; this generator jumps past it
+    Rng split()
+    {
+        Rng stream = *this;
+        jump();
+        return stream;
+    }
+
+    // Stream `index` of `seed`: the seed's generator after `index` jumps
+    static Rng stream(uint64_t seed, unsigned index);
+
+    // Seed of the process-wide master: POKER_SEED, else random_device
+    static uint64_t processSeed();
+
+    // Next stream of the process-wide master (thread-safe)
+    static Rng nextStream();
+
+private:
+    friend class RngLanes;
+
+    uint64_t state[4];
+
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+};
+
+/**
+ * RngLanes - several xoshiro256** streams stepped in lockstep
+ *
+ * Lane i is the i-th split() of the generator it is built from. The state
+ * is stored lane-minor, so one step is a loop over LANES words with no
+ * dependency between them, which the compiler turns into vector code;
+ * the multiplies are written as shifts and adds for the same reason.
+ */
+class RngLanes
+{
+public:
+    static constexpr int LANES = 4;
+
+    explicit RngLanes(Rng &master)
+    {
+        for (int lane = 0; lane < LANES; ++lane)
+        {
+            Rng stream = master.split();
+            for (int w = 0; w < 4; ++w)
+                state[w][lane] = stream.state[w];
+        }
+    }
+
+    // n outputs, interleaved across the lanes; n must be a multiple of LANES
+    void fill(uint64_t *out, size_t n)
+    {
+        for (size_t i = 0; i < n; i += LANES)
+        {
+            for (int lane = 0; lane < LANES; ++lane)
+            {
+                uint64_t x = state[1][lane] + (state[1][lane] << 2);
+                x = (x << 7) | (x >> 57);
+                out[i + lane] = x + (x << 3);
+
+                const uint64_t t = state[1][lane] << 17;
+                state[2][lane] ^= state[0][lane];
+                state[3][lane] ^= state[1][lane];
+                state[1][lane] ^= state[2][lane];
+                state[0][lane] ^= state[3][lane];
+                state[2][lane] ^= t;
+                state[3][lane] = (state[3][lane] << 45) | (state[3][lane] >> 19);
+            }
+        }
+    }
+
+private:
+    uint64_t state[4][LANES];
+};
+
+#endif // RNG_H
@@ -0,0 +1,95 @@
+#ifndef SHARED_BOARD_H
+#define SHARED_BOARD_H
+
+#include "card.h"
+#include "card_set.h"
+#include "fixed_hand_evaluator.h"
+#include "rank_tables.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Two hole cards, as dealt to one Hold'em player
+using HolePair = std::array<CardId, 2>;
+
+/**
+ * SharedBoard - community cards prepared once for many hole pairs
+ *
+ * The board's rank multiplicity masks and its one possible flush suit are
+ * computed up front; scoring a hole pair then only pushes two rank bits
+ * through the masks and asks RANK_TABLES whether the flush suit reached
+ * five cards. Scores equal BitmaskHandEvaluator's for the combined hand.
+ *
+ * Hole cards must not repeat board cards; that is not checked.
+ */
+class SharedBoard
+{
+public:
+    static SharedBoard of(CardSpan board)
+    {
+        return of(CardSet::fromCards(board));
+    }
+
+    static SharedBoard of(CardSet board)
+    {
+        const uint32_t c = board.suitMask(0);
+        const uint32_t d = board.suitMask(1);
+        const uint32_t h = board.suitMask(2);
+        const uint32_t s = board.suitMask(3);
+
+        SharedBoard shared;
+        shared.atLeast[0] = c | d | h | s;
+        shared.atLeast[1] = (c & d) | (h & s) | ((c | d) & (h | s));
+        shared.atLeast[2] = (c & d & (h | s)) | (h & s & (c | d));
+        shared.atLeast[3] = c & d & h & s;
+
+        // Two hole cards can only complete a suit the board shows three times
+        for (int suit = 0; suit < 4; ++suit)
+        {
+            if (rankCountOf(board.suitMask(suit)) >= 3)
+            {
+                shared.flushSuit = suit;
+                shared.flushRanks = board.suitMask(suit);
+            }
+        }
+        return shared;
+    }
+
+    uint32_t score(HolePair hole) const
+    {
+        uint32_t m0 = atLeast[0], m1 = atLeast[1], m2 = atLeast[2], m3 = atLeast[3];
+        uint32_t flush = flushRanks;
+        for (CardId id : hole)
+        {
+            // The rank moves up to the first count it has not reached yet
+            uint32_t bit = 1u << (id % 13);
+            uint32_t carry = bit & m0;
+            m0 |= bit;
+            uint32_t next = carry & m1;
+            m1 |= carry;
+            carry = next & m2;
+            m2 |= next;
+            m3 |= carry;
+
+            if (id / 13 == flushSuit)
+                flush |= bit;
+        }
+        if (rankCountOf(flush) < 5)
+            flush = 0;
+        return FixedHandEvaluator::scoreMasks(m0, m1, m2, m3, flush);
+    }
+
+    void score(const HolePair *holes, uint32_t *out, size_t n) const
+    {
+        for (size_t i = 0; i < n; ++i)
+            out[i] = score(holes[i]);
+    }
+
+private:
+    uint32_t atLeast[4] = {0, 0, 0, 0}; // bit r set when rank r + 2 appears N+ times
+    int flushSuit = -1;                 // the suit with three or more board cards
+    uint32_t flushRanks = 0;            // its board ranks
+};
+
+#endif // SHARED_BOARD_H
@@ -0,0 +1,211 @@
+// short_deck_evaluator.cpp
+#include "short_deck_evaluator.h"
+#include <stdexcept>
+
+/**
+ * Per-rank keys (Six first) whose sums over seven cards with at most four
+ * of a rank are all distinct; found by a greedy search.
+ */
+static const uint32_t RANK_KEY[9] = {0, 1, 5, 22, 98, 453, 2031, 8698, 22854};
+static const uint32_t MAX_KEY_SUM = 4 * 22854 + 3 * 8698;
+
+// The Six is bit 4 of a 13-bit rank mask
+static const int SHIFT = ShortDeckEvaluator::LOWEST_RANK - 2;
+
+// Position of each HandRank in the short-deck order: Flush above Full House
+static const uint32_t CATEGORY_ORDER[10] = {0, 1, 2, 3, 4, 6, 5, 7, 8, 9};
+
+static inline int highBit(uint32_t mask)
+{
+    return 31 - __builtin_clz(mask);
+}
+
+/**
+ * High card of the best straight in a 13-bit rank mask, 0 if none;
+ * the Ace also plays below the Six
+ */
+static inline int straightHigh(uint32_t ranks)
+{
+    uint32_t m = ranks & (ranks >> 1) & (ranks >> 2) & (ranks >> 3) & (ranks >> 4);
+    if (m)
+        return highBit(m) + 6; // bit of the run's lowest card + 4 higher, as a rank
+    const uint32_t wheel = (1u << 12) | (0xFu << SHIFT); // A-6-7-8-9
+    return (ranks & wheel) == wheel ? 9 : 0;
+}
+
+static inline uint32_t appendTop(uint32_t score, uint32_t ranks, int count)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        uint32_t nibble = 0;
+        if (ranks)
+        {
+            int r = highBit(ranks);
+            nibble = r + 2;
+            ranks &= ~(1u << r);
+        }
+        score = (score << 4) | nibble;
+    }
+    return score;
+}
+
+static inline uint32_t pack(HandRank rank, uint32_t kickers, int count)
+{
+    uint32_t category = static_cast<uint32_t>(rank);
+    return (CATEGORY_ORDER[category] << HandValue::ORDER_SHIFT) |
+           (category << HandValue::CATEGORY_SHIFT) |
+           (kickers << (4 * (5 - count)));
+}
+
+/**
+ * Score from rank multiplicity masks (13-bit layout), in short-deck order
+ */
+static uint32_t scoreMasks(uint32_t atLeast1, uint32_t atLeast2, uint32_t atLeast3,
+                           uint32_t atLeast4, uint32_t flush)
+{
+    if (flush)
+    {
+        int sfHigh = straightHigh(flush);
+        if (sfHigh == 14)
+            return pack(HandRank::RoyalFlush, 14, 1);
+        if (sfHigh)
+            return pack(HandRank::StraightFlush, sfHigh, 1);
+    }
+
+    if (atLeast4)
+    {
+        int quad = highBit(atLeast4);
+        return pack(HandRank::FourOfAKind, appendTop(quad + 2, atLeast1 & ~(1u << quad), 1), 2);
+    }
+
+    if (flush)
+        return pack(HandRank::Flush, appendTop(0, flush, 5), 5);
+
+    if (atLeast3)
+    {
+        int trip = highBit(atLeast3);
+        uint32_t pairs = atLeast2 & ~(1u << trip);
+        if (pairs)
+            return pack(HandRank::FullHouse, appendTop(trip + 2, pairs, 1), 2);
+    }
+
+    if (int high = straightHigh(atLeast1))
+        return pack(HandRank::Straight, high, 1);
+
+    if (atLeast3)
+    {
+        int trip = highBit(atLeast3);
+        return pack(HandRank::ThreeOfAKind, appendTop(trip + 2, atLeast1 & ~(1u << trip), 2), 3);
+    }
+
+    if (atLeast2)
+    {
+        int high = highBit(atLeast2);
+        uint32_t rest = atLeast2 & ~(1u << high);
+        if (rest)
+        {
+            int low = highBit(rest);
+            uint32_t kickers = atLeast1 & ~(1u << high) & ~(1u << low);
+            return pack(HandRank::TwoPair, appendTop(((high + 2) << 4) | (low + 2), kickers, 1), 3);
+        }
+        return pack(HandRank::OnePair, appendTop(high + 2, atLeast1 & ~(1u << high), 3), 4);
+    }
+
+    return pack(HandRank::HighCard, appendTop(0, atLeast1, 5), 5);
+}
+
+struct ShortDeckTables
+{
+    uint32_t unsuited[MAX_KEY_SUM + 1]; // key sum of 7 cards -> score
+    uint32_t flush[512];                // 9-bit mask of a suit with 5+ cards -> score
+    uint32_t keySum[512];               // 9-bit mask -> sum of its ranks' keys
+
+    ShortDeckTables() : unsuited(), flush(), keySum()
+    {
+        for (uint32_t mask = 0; mask < 512; ++mask)
+        {
+            for (int r = 0; r < 9; ++r)
+                if (mask & (1u << r))
+                    keySum[mask] += RANK_KEY[r];
+            if (__builtin_popcount(mask) >= 5)
+                flush[mask] = scoreMasks(mask << SHIFT, 0, 0, 0, mask << SHIFT);
+        }
+
+        int counts[9] = {};
+        fillUnsuited(0, 7, counts);
+    }
+
+    // Every rank multiset of `left` more cards, ranks from `from` upwards
+    void fillUnsuited(int from, int left, int *counts)
+    {
+        if (left == 0)
+        {
+            uint32_t atLeast[4] = {0, 0, 0, 0};
+            uint32_t key = 0;
+            for (int r = 0; r < 9; ++r)
+            {
+                for (int n = 0; n < counts[r]; ++n)
+                    atLeast[n] |= 1u << (r + SHIFT);
+                key += counts[r] * RANK_KEY[r];
+            }
+            unsuited[key] = scoreMasks(atLeast[0], atLeast[1], atLeast[2], atLeast[3], 0);
+            return;
+        }
+        for (int r = from; r < 9; ++r)
+        {
+            if (counts[r] == 4)
+                continue;
+            counts[r]++;
+            fillUnsuited(r, left - 1, counts);
+            counts[r]--;
+        }
+    }
+};
+
+static const ShortDeckTables &tables()
+{
+    static const ShortDeckTables instance;
+    return instance;
+}
+
+uint32_t ShortDeckEvaluator::evaluate(CardSet cards)
+{
+    const ShortDeckTables &t = tables();
+    const uint32_t c = cards.suitMask(0) >> SHIFT;
+    const uint32_t d = cards.suitMask(1) >> SHIFT;
+    const uint32_t h = cards.suitMask(2) >> SHIFT;
+    const uint32_t s = cards.suitMask(3) >> SHIFT;
+
+    if (t.flush[c])
+        return t.flush[c];
+    if (t.flush[d])
+        return t.flush[d];
+    if (t.flush[h])
+        return t.flush[h];
+    if (t.flush[s])
+        return t.flush[s];
+
+    if (__builtin_popcountll(cards.bits) == 7)
+        return t.unsuited[t.keySum[c] + t.keySum[d] + t.keySum[h] + t.keySum[s]];
+
+    // Flop and turn sizes: score straight from the masks
+    return scoreMasks((c | d | h | s) << SHIFT,
+                      ((c & d) | (h & s) | ((c | d) & (h | s))) << SHIFT,
+                      ((c & d & (h | s)) | (h & s & (c | d))) << SHIFT,
+                      (c & d & h & s) << SHIFT,
+                      0);
+}
+
+HandValue ShortDeckEvaluator::evaluate(CardSpan cards)
+{
+    if (cards.size() < 5)
+    {
+        throw std::invalid_argument("At least 5 cards are required for hand evaluation");
+    }
+    for (const Card &c : cards)
+    {
+        if (static_cast<int>(c.rank) < LOWEST_RANK)
+            throw std::invalid_argument("Short deck has no cards below Six");
+    }
+    return HandValue::fromScore(evaluate(CardSet::fromCards(cards)));
+}
@@ -0,0 +1,39 @@
+#ifndef SHORT_DECK_EVALUATOR_H
+#define SHORT_DECK_EVALUATOR_H
+
+#include "card.h"
+#include "card_set.h"
+#include "hand_types.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * Short-deck (6+) hold'em evaluator
+ *
+ * The deck is Six through Ace in four suits (36 cards). A flush beats a
+ * full house, and A-6-7-8-9 is the lowest straight. Scores carry the
+ * short-deck category order in bits 24-27 (HandValue::ORDER_SHIFT), so they
+ * compare correctly with each other but not with Hold'em scores.
+ *
+ * With only nine ranks the 7-card tables are small enough for L2:
+ *   - unsuited hands are one lookup by the sum of per-rank keys (470 KB),
+ *     the sum being unique for every 7-card rank multiset;
+ *   - a flush is one lookup by the suit's 9-bit rank mask.
+ * No 7-card hand holds a flush together with anything stronger, so a
+ * flush never needs the unsuited lookup. 5 and 6 card hands are scored
+ * directly from rank masks.
+ */
+class ShortDeckEvaluator
+{
+public:
+    static constexpr int LOWEST_RANK = 6;
+    static constexpr int DECK_SIZE = 36;
+
+    // 5 to 7 cards, all Six or higher
+    static uint32_t evaluate(CardSet cards);
+
+    // Throws below 5 cards or on a card below Six
+    static HandValue evaluate(CardSpan cards);
+};
+
+#endif // SHORT_DECK_EVALUATOR_H
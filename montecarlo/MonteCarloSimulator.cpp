@@ -1,101 +1,941 @@
 // montecarlo/MonteCarloSimulator.cpp
 #include "MonteCarloSimulator.h"
+#include "../model/combinatorics.h"
 #include "../model/deck.h"
-#include "../model/advanced_hand_evaluator.h"
+#include "../model/evaluator_registry.h"
+#include "../model/kronecker_deck.h"
+#include "../model/omaha_hand_evaluator.h"
+#include "../model/poker_math.h"
+#include "../model/shared_board.h"
+#include "../model/short_deck_evaluator.h"
+#include "../utils/work_stealing_pool.h"
 
 #include <random>
 #include <algorithm>
 #include <iostream>
-#include <map>
 #include <cmath>  // for sqrt, max, min
+#include <limits>
+#include <stdexcept>
 
 MonteCarloSimulator::MonteCarloSimulator(const std::vector<Card> &playerHand,
                                          const std::vector<Card> &communityCards,
-                                         int simulations)
+                                         int simulations,
+                                         GameVariant variant,
+                                         int opponents)
     : playerHand(playerHand), communityCards(communityCards),
-      numSimulations(simulations), winCount(0), tieCount(0), loseCount(0)
+      knownBoard(CardSet::fromCards(communityCards)),
+      deadCards(CardSet::fromCards(playerHand) | knownBoard),
+      numSimulations(simulations), variant(variant), opponents(opponents),
+      seed(Rng::nextStream()())
 {
+    if (isOmaha(variant) && playerHand.size() != OmahaHandEvaluator::HOLE_CARDS)
+    {
+        throw std::invalid_argument("Omaha needs exactly 4 hole cards");
+    }
+    if (!deadCards.without(CardSet::fullDeck(lowestRank(variant))).empty())
+    {
+        throw std::invalid_argument("Card is not part of this variant's deck");
+    }
+    if (opponents < 1 || opponents > MAX_OPPONENTS)
+    {
+        throw std::invalid_argument("Simulations need 1 to 9 opponents");
+    }
+}
+
+namespace
+{
+    /**
+     * A complete board prepared once under the variant's rules, so each
+     * seat's hole cards are scored against it without a full evaluation:
+     * Hold'em pushes two hole cards through the SharedBoard masks, Omaha
+     * reuses the board's 3-card subsets
+     */
+    class PreparedBoard
+    {
+    public:
+        PreparedBoard(GameVariant variant, CardSet board)
+            : variant(variant), board(board), shared(SharedBoard::of(board))
+        {
+            if (isOmaha(variant))
+            {
+                CardId ids[5];
+                int n = 0;
+                for (CardId id : board)
+                    ids[n++] = id;
+                omaha = OmahaHandEvaluator::Board::of(ids, n);
+            }
+        }
+
+        HiLoScore score(const CardId *hole) const
+        {
+            if (isOmaha(variant))
+            {
+                if (isHiLo(variant))
+                    return OmahaHandEvaluator::evaluateHiLo(omaha, hole);
+                return HiLoScore{OmahaHandEvaluator::evaluate(omaha, hole), LowHandEvaluator::NO_LOW};
+            }
+
+            const CardSet hand = board | CardSet::of(hole[0]) | CardSet::of(hole[1]);
+            if (variant == GameVariant::ShortDeck)
+                return HiLoScore{ShortDeckEvaluator::evaluate(hand), LowHandEvaluator::NO_LOW};
+
+            const uint32_t high = shared.score(HolePair{hole[0], hole[1]});
+            return HiLoScore{high, isHiLo(variant) ? LowHandEvaluator::evaluate(hand) : LowHandEvaluator::NO_LOW};
+        }
+
+    private:
+        GameVariant variant;
+        CardSet board;
+        SharedBoard shared;
+        OmahaHandEvaluator::Board omaha;
+    };
+
+    // Independent draws matching the win rate's variance; trials when it is certain
+    double effectiveSamples(double win, double variance, long long trials)
+    {
+        const double spread = win * (1.0 - win);
+        if (spread == 0.0)
+            return static_cast<double>(trials);
+        if (variance == 0.0)
+            return std::numeric_limits<double>::infinity();
+        return spread / variance;
+    }
 }
 
 void MonteCarloSimulator::runSimulation()
 {
-    winCount = tieCount = loseCount = 0;
+    WorkStealingPool &pool = WorkStealingPool::shared();
+    std::vector<Tally> tallies(pool.size());
+
+    exact = mode == Mode::Exact ||
+            (mode == Mode::Auto && opponents == 1 && exactCombinations() <= static_cast<uint64_t>(numSimulations));
+    planSampling();
+    if (exact)
+        runExact(tallies);
+    else
+        runSampled(tallies);
 
-    std::vector<Card> fullHand = playerHand;
-    fullHand.insert(fullHand.end(), communityCards.begin(), communityCards.end());
+    // Integer sums: the same totals whichever worker counted what
+    Tally total;
+    for (const Tally &t : tallies)
+        total += t;
 
-    for (int i = 0; i < numSimulations; ++i)
+    result = estimateOf(total);
+    trialCount = total.win + total.tie + total.lose;
+}
+
+/**
+ * Decide how a sampled run deals. Stratified, each opponent holding is a
+ * stratum (each first hole card in Omaha, whose holdings are too many),
+ * provided the budget gives every stratum two samples or more.
+ *
+ * The control is the category of the player's final hand. Its exact mean
+ * comes from scoring the player on every runout once, which is done when
+ * that costs at most a quarter of the budget (one or two cards to come).
+ * A stratum's mean leaves out the runouts holding its fixed cards.
+ */
+void MonteCarloSimulator::planSampling()
+{
+    plan = SamplingPlan();
+    plan.reduced = !exact && opponents == 1 && (reduction.stratified || reduction.controlVariate);
+    if (!plan.reduced)
     {
-        // Get remaining cards to deal from
-        std::vector<Card> deck = getRemainingDeck();
+        if (exact || sampler != Sampler::QuasiRandom)
+            return;
 
-        // Shuffle the deck
-        std::random_device rd;
-        std::mt19937 g(rd());
-        std::shuffle(deck.begin(), deck.end(), g);
+        const int chunks = (numSimulations + chunkTrials - 1) / chunkTrials;
+        plan.quasi = true;
+        plan.replicates = std::max(1, std::min(REPLICATES, chunks));
+        plan.dimensions = opponents * holeCardCount(variant) + 5 - knownBoard.size();
+        return;
+    }
 
-        // Deal opponent hand and complete the board if needed
-        auto [opponentHand, completeBoard] = dealRandomOpponentAndBoard(deck);
+    const CardSet live = CardSet::fullDeck(lowestRank(variant)).without(deadCards);
+    int position[52];
+    for (CardId id : live)
+    {
+        position[id] = plan.liveCount;
+        plan.live[plan.liveCount++] = id;
+    }
+
+    const int count = plan.liveCount;
+    const int holeCards = holeCardCount(variant);
+    const int missing = 5 - knownBoard.size();
+
+    plan.fixedCards = holeCards == 2 ? 2 : 1;
+    const long long strata = plan.fixedCards == 2 ? choose(count, 2) : count;
+    if (reduction.stratified && numSimulations >= 2 * strata)
+    {
+        for (int a = 0; a < count; ++a)
+        {
+            if (plan.fixedCards == 1)
+                plan.strata.push_back({static_cast<uint8_t>(a), 0});
+            else
+                for (int b = a + 1; b < count; ++b)
+                    plan.strata.push_back({static_cast<uint8_t>(a), static_cast<uint8_t>(b)});
+        }
+    }
+    else
+    {
+        plan.fixedCards = 0;
+        plan.strata.assign(1, {0, 0});
+    }
+
+    plan.controlMean.assign(plan.strata.size(), 0.0);
+    plan.control = reduction.controlVariate && missing >= 1 && missing <= 2 &&
+                   4 * choose(count, missing) <= static_cast<uint64_t>(numSimulations);
+    if (!plan.control)
+        return;
+
+    CardId playerIds[OmahaHandEvaluator::HOLE_CARDS];
+    for (int i = 0; i < holeCards; ++i)
+        playerIds[i] = toCardId(playerHand[i]);
+
+    // The category on every runout, in total, per card in the runout and,
+    // with two to come, per pair
+    double total = 0.0;
+    std::vector<double> withCard(count, 0.0);
+    std::vector<double> onPair(missing == 2 ? count * count : 0, 0.0);
+    for (CardSet runout : SubsetRange(live, missing))
+    {
+        const double category = PreparedBoard(variant, knownBoard | runout).score(playerIds).high >>
+                                HandValue::CATEGORY_SHIFT;
+        total += category;
+        int at[2], n = 0;
+        for (CardId id : runout)
+        {
+            at[n++] = position[id];
+            withCard[position[id]] += category;
+        }
+        if (missing == 2)
+            onPair[at[0] * count + at[1]] = category;
+    }
+
+    const double runouts = static_cast<double>(choose(count, missing));
+    const double perCard = static_cast<double>(choose(count - 1, missing - 1));
+    for (size_t h = 0; h < plan.strata.size(); ++h)
+    {
+        const auto [a, b] = plan.strata[h];
+        double sum = total, n = runouts;
+        for (int i = 0; i < plan.fixedCards; ++i)
+        {
+            sum -= withCard[plan.strata[h][i]];
+            n -= perCard;
+        }
+        if (plan.fixedCards == 2 && missing == 2)
+        {
+            sum += onPair[a * count + b];
+            n += 1.0;
+        }
+        plan.controlMean[h] = sum / n;
+    }
+}
+
+/**
+ * Probabilities from the summed tallies. Plain and exact runs divide the
+ * counts; the win variance of a quasi-random run is the spread of its
+ * replicates' win rates around the pooled one, each weighted by its share
+ * of the trials. Reduced runs average the strata, weighted equally since every
+ * opponent holding is equally likely, after moving each stratum's rates
+ * by their slope on the control times how far its control strayed from
+ * the exact mean; the slopes are pooled within strata. The win variance
+ * comes from what the control leaves unexplained in each stratum.
+ */
+MonteCarloSimulator::Estimate MonteCarloSimulator::estimateOf(const Tally &total) const
+{
+    Estimate e;
+    const long long trials = total.win + total.tie + total.lose;
+    if (trials == 0)
+        return e;
+
+    if (!plan.reduced)
+    {
+        e.win = static_cast<double>(total.win) / trials;
+        e.tie = static_cast<double>(total.tie) / trials;
+        e.lose = static_cast<double>(total.lose) / trials;
+        e.scoop = static_cast<double>(total.scoop) / trials;
+        e.highOnly = static_cast<double>(total.highOnly) / trials;
+        e.lowOnly = static_cast<double>(total.lowOnly) / trials;
+        e.equity = static_cast<double>(total.equity) / (static_cast<double>(EQUITY_UNIT) * trials);
+        if (exact)
+        {
+            e.effectiveSamples = std::numeric_limits<double>::infinity();
+            return e;
+        }
+
+        e.winVariance = e.win * (1.0 - e.win) / trials;
+        if (plan.quasi && plan.replicates > 1)
+        {
+            double spread = 0.0;
+            for (const GroupSums &r : total.groups)
+            {
+                if (r.samples == 0)
+                    continue;
+                const double share = static_cast<double>(r.samples) / trials;
+                const double deviation = static_cast<double>(r.win) / r.samples - e.win;
+                spread += share * share * deviation * deviation;
+            }
+            e.winVariance = spread * plan.replicates / (plan.replicates - 1);
+        }
+        e.effectiveSamples = effectiveSamples(e.win, e.winVariance, trials);
+        return e;
+    }
+
+    double controlSpread = 0.0, winCovariance = 0.0, tieCovariance = 0.0, equityCovariance = 0.0;
+    int filled = 0;
+    for (const GroupSums &s : total.groups)
+    {
+        if (s.samples == 0)
+            continue;
+        const double n = static_cast<double>(s.samples);
+        filled++;
+        controlSpread += s.controlSquares - s.control * (s.control / n);
+        winCovariance += s.winControl - s.win * (s.control / n);
+        tieCovariance += s.tieControl - s.tie * (s.control / n);
+        equityCovariance += s.equityControl - s.equity * (s.control / n);
+    }
+    const double winSlope = controlSpread > 0.0 ? winCovariance / controlSpread : 0.0;
+    const double tieSlope = controlSpread > 0.0 ? tieCovariance / controlSpread : 0.0;
+    const double equitySlope = controlSpread > 0.0 ? equityCovariance / controlSpread : 0.0;
+
+    const double weight = 1.0 / filled;
+    for (size_t h = 0; h < total.groups.size(); ++h)
+    {
+        const GroupSums &s = total.groups[h];
+        if (s.samples == 0)
+            continue;
+        const double n = static_cast<double>(s.samples);
+        const double shift = s.control / n - plan.controlMean[h];
+
+        e.win += weight * (s.win / n - winSlope * shift);
+        e.tie += weight * (s.tie / n - tieSlope * shift);
+        e.equity += weight * (s.equity / n - equitySlope * shift);
+        e.scoop += weight * s.scoop / n;
+        e.highOnly += weight * s.highOnly / n;
+        e.lowOnly += weight * s.lowOnly / n;
+
+        if (s.samples > 1)
+        {
+            const double spread = s.controlSquares - s.control * (s.control / n);
+            const double covariance = s.winControl - s.win * (s.control / n);
+            const double residual = (s.win - s.win * (s.win / n)) - 2.0 * winSlope * covariance +
+                                    winSlope * winSlope * spread;
+            e.winVariance += weight * weight * std::max(0.0, residual) / ((n - 1.0) * n);
+        }
+    }
+
+    // The correction can push a rate just past 0 or 1
+    e.win = std::clamp(e.win, 0.0, 1.0);
+    e.tie = std::clamp(e.tie, 0.0, 1.0 - e.win);
+    e.lose = 1.0 - e.win - e.tie;
+    e.equity = std::clamp(e.equity / EQUITY_UNIT, 0.0, 1.0);
+
+    e.effectiveSamples = effectiveSamples(e.win, e.winVariance, trials);
+    return e;
+}
+
+void MonteCarloSimulator::setStoppingRule(double halfWidth, double threshold, double confidence, int firstRound)
+{
+    if (halfWidth <= 0.0 || confidence <= 0.0 || confidence >= 1.0)
+    {
+        throw std::invalid_argument("Stopping rule needs a positive half-width and a confidence in (0, 1)");
+    }
+    if (firstRound < 1 || firstRound > CHUNK_TRIALS)
+    {
+        throw std::invalid_argument("Stopping rule's first round must be 1 to CHUNK_TRIALS trials");
+    }
+    targetHalfWidth = halfWidth;
+    decisionThreshold = threshold;
+    stopConfidence = confidence;
+    chunkTrials = firstRound;
+}
+
+void MonteCarloSimulator::runSampled(std::vector<Tally> &tallies)
+{
+    const int chunks = (numSimulations + chunkTrials - 1) / chunkTrials;
+    WorkStealingPool &pool = WorkStealingPool::shared();
+
+    // Scratch decks per worker; each chunk reseeds its worker's deck, so
+    // only the chunk decides the cards
+    std::vector<Deck> decks(pool.size(), getRemainingDeck(Rng(seed)));
+
+    // Stream 0 of the seed draws the quasi-random shifts and chunk c deals
+    // from stream c + 1. Chunk streams are split as their round is
+    // scheduled, so a run that stops early skips the jumps of the rest
+    Rng master(seed);
+    Rng shiftSource = master.split();
+    plan.shifts.resize(static_cast<size_t>(plan.replicates) * plan.dimensions);
+    for (uint64_t &shift : plan.shifts)
+        shift = shiftSource();
+
+    std::vector<Rng> streams(chunks);
+    int splitChunks = 0;
+
+    std::vector<KroneckerDeck> sequences;
+    if (plan.quasi)
+        sequences.assign(pool.size(), KroneckerDeck(variant, deadCards, plan.dimensions));
+
+    for (Tally &t : tallies)
+        t.groups.assign(plan.reduced ? plan.strata.size() : plan.replicates, GroupSums());
+
+    auto runChunks = [&](int first, int last) {
+        for (; splitChunks < last; ++splitChunks)
+            streams[splitChunks] = master.split();
+
+        pool.run(last - first, [&](size_t index, unsigned worker) {
+            const int chunk = first + static_cast<int>(index);
+            const int trials = std::min(chunkTrials, numSimulations - chunk * chunkTrials);
+            if (plan.reduced)
+            {
+                // Sample numbers run on across chunks so strata stay balanced
+                Rng rng = streams[chunk];
+                runReducedTrials(rng, static_cast<long long>(chunk) * chunkTrials, trials, tallies[worker]);
+                return;
+            }
+
+            if (plan.quasi)
+            {
+                const int replicate = chunk % plan.replicates;
+                KroneckerDeck &deck = sequences[worker];
+                deck.start(&plan.shifts[replicate * plan.dimensions],
+                           static_cast<uint64_t>(chunk / plan.replicates) * chunkTrials);
+
+                Tally part;
+                dealTrials(deck, trials, part);
+                tallies[worker] += part;
+                tallies[worker].groups[replicate].samples += trials;
+                tallies[worker].groups[replicate].win += part.win;
+                return;
+            }
+
+            Deck &deck = decks[worker];
+            deck.seed(streams[chunk]);
+            dealTrials(deck, trials, tallies[worker]);
+        }, threadCount);
+    };
+
+    if (targetHalfWidth <= 0.0)
+    {
+        runChunks(0, chunks);
+        return;
+    }
+
+    // Double the trials between looks; look k may be wrong with
+    // probability alpha / 2^k, so all of them together with at most alpha
+    const double alpha = 1.0 - stopConfidence;
+    int done = 0;
+    for (int look = 1; done < chunks; ++look)
+    {
+        // Quasi-random looks wait for a chunk of every replicate
+        const int next = std::min(chunks, std::max(plan.quasi ? plan.replicates : 1, 2 * done));
+        runChunks(done, next);
+        done = next;
+
+        Tally total;
+        for (const Tally &t : tallies)
+            total += t;
+        if (intervalSettled(total, PokerMath::zScore(1.0 - std::ldexp(alpha, -look))))
+            break;
+    }
+}
+
+// True once PokerMath::intervalSettled holds for the run so far
+bool MonteCarloSimulator::intervalSettled(const Tally &total, double z) const
+{
+    const double n = static_cast<double>(total.win + total.tie + total.lose);
+    if (n < 2.0 * total.groups.size())
+        return false; // some stratum has no spread yet
+
+    // Variance reduction narrows the spread as if there were more trials
+    const Estimate estimate = estimateOf(total);
+    const double margin = PokerMath::winRateMargin(total.win, n, estimate.effectiveSamples, z);
+    return PokerMath::intervalSettled(estimate.win, margin, targetHalfWidth, decisionThreshold);
+}
+
+uint64_t MonteCarloSimulator::exactCombinations() const
+{
+    const int live = CardSet::fullDeck(lowestRank(variant)).without(deadCards).size();
+    const int missing = 5 - knownBoard.size();
+    return choose(live, missing) * choose(live - missing, holeCardCount(variant));
+}
+
+/**
+ * Every board runout against every opponent holding from the cards left.
+ * Runouts are split into ranges for the pool; each runout is prepared
+ * once and the player scored once, then each holding costs one score.
+ *
+ * Holdings are scored against a PreparedBoard rather than by advancing an
+ * EvalState per dealt card. EvalState re-evaluates on every card past the
+ * fifth, so board + two hole cards costs two evaluations where SharedBoard
+ * costs one (about 1.8x slower over a Hold'em turn), and it only knows
+ * Hold'em high hands, not Omaha, short deck or the Hi/Lo low.
+ */
+void MonteCarloSimulator::runExact(std::vector<Tally> &tallies)
+{
+    if (opponents != 1)
+    {
+        throw std::invalid_argument("Exact enumeration handles a single opponent");
+    }
+
+    const CardSet live = CardSet::fullDeck(lowestRank(variant)).without(deadCards);
+    const SubsetRange runouts(live, 5 - knownBoard.size());
+    const int holeCards = holeCardCount(variant);
+
+    CardId playerIds[OmahaHandEvaluator::HOLE_CARDS];
+    for (int i = 0; i < holeCards; ++i)
+        playerIds[i] = toCardId(playerHand[i]);
+
+    // A few ranges per worker so stealing can even out the tail
+    WorkStealingPool &pool = WorkStealingPool::shared();
+    const std::vector<SubsetRange> parts =
+        runouts.split(static_cast<int>(std::min<uint64_t>(runouts.size(), 4 * pool.size())));
+
+    pool.run(parts.size(), [&](size_t part, unsigned worker) {
+        Tally &tally = tallies[worker];
+        for (CardSet runout : parts[part])
+        {
+            const PreparedBoard board(variant, knownBoard | runout);
+            HiLoScore seats[2] = {board.score(playerIds), {}};
+
+            for (CardSet hole : SubsetRange(live.without(runout), holeCards))
+            {
+                CardId ids[OmahaHandEvaluator::HOLE_CARDS];
+                int n = 0;
+                for (CardId id : hole)
+                    ids[n++] = id;
+
+                seats[1] = board.score(ids);
+                recordShowdown(seats, 2, tally);
+            }
+        }
+    }, threadCount);
+}
+
+MonteCarloSimulator::GroupSums &MonteCarloSimulator::GroupSums::operator+=(const GroupSums &other)
+{
+    samples += other.samples;
+    win += other.win;
+    tie += other.tie;
+    scoop += other.scoop;
+    highOnly += other.highOnly;
+    lowOnly += other.lowOnly;
+    equity += other.equity;
+    control += other.control;
+    controlSquares += other.controlSquares;
+    winControl += other.winControl;
+    tieControl += other.tieControl;
+    equityControl += other.equityControl;
+    return *this;
+}
+
+MonteCarloSimulator::Tally &MonteCarloSimulator::Tally::operator+=(const Tally &other)
+{
+    win += other.win;
+    tie += other.tie;
+    lose += other.lose;
+    scoop += other.scoop;
+    highOnly += other.highOnly;
+    lowOnly += other.lowOnly;
+    equity += other.equity;
+
+    if (groups.size() < other.groups.size())
+        groups.resize(other.groups.size());
+    for (size_t h = 0; h < other.groups.size(); ++h)
+        groups[h] += other.groups[h];
+    return *this;
+}
+
+// High scores of whole Hold'em or short deck hands in one batch
+void MonteCarloSimulator::scoreHands(const CardSet *hands, uint32_t *scores, int count) const
+{
+    if (variant == GameVariant::ShortDeck)
+    {
+        for (int i = 0; i < count; ++i)
+            scores[i] = ShortDeckEvaluator::evaluate(hands[i]);
+        return;
+    }
+    EvaluatorRegistry::active().evaluateBatch(hands, scores, count);
+}
+
+template <class Cards>
+void MonteCarloSimulator::dealTrials(Cards &deck, int trials, Tally &tally) const
+{
+    if (opponents > 1)
+        runMultiwayTrials(deck, trials, tally);
+    else if (isOmaha(variant))
+        runOmahaTrials(deck, trials, tally);
+    else
+        runTrials(deck, trials, tally);
+}
+
+template <class Cards>
+void MonteCarloSimulator::runTrials(Cards &deck, int trials, Tally &tally) const
+{
+    // Trials are dealt a block at a time and scored together, player hands
+    // in even slots and opponent hands in odd slots
+    const int BLOCK_SIZE = 256;
+    CardSet hands[2 * BLOCK_SIZE];
+    uint32_t scores[2 * BLOCK_SIZE];
+
+    const CardSet playerCards = CardSet::fromCards(playerHand);
 
-        // Combine player hand with board
-        std::vector<Card> playerFullHand = playerHand;
-        playerFullHand.insert(playerFullHand.end(), completeBoard.begin(), completeBoard.end());
+    for (int done = 0; done < trials; done += BLOCK_SIZE)
+    {
+        int blockTrials = std::min(BLOCK_SIZE, trials - done);
+
+        for (int t = 0; t < blockTrials; ++t)
+        {
+            // Deal opponent hand and complete the board if needed
+            auto [opponentHand, completeBoard] = dealRandomOpponentAndBoard(deck);
 
-        // Combine opponent hand with board
-        std::vector<Card> opponentFullHand = opponentHand;
-        opponentFullHand.insert(opponentFullHand.end(), completeBoard.begin(), completeBoard.end());
+            hands[2 * t] = playerCards | completeBoard;
+            hands[2 * t + 1] = opponentHand | completeBoard;
+        }
 
-        // Evaluate both hands
-        HandValue playerValue = AdvancedHandEvaluator::evaluate(playerFullHand);
-        HandValue opponentValue = AdvancedHandEvaluator::evaluate(opponentFullHand);
+        scoreHands(hands, scores, 2 * blockTrials);
+
+        if (isHiLo(variant))
+        {
+            // The lows come from the same CardSets the high pass just scored
+            for (int t = 0; t < blockTrials; ++t)
+            {
+                const HiLoScore seats[2] = {{scores[2 * t], LowHandEvaluator::evaluate(hands[2 * t])},
+                                            {scores[2 * t + 1], LowHandEvaluator::evaluate(hands[2 * t + 1])}};
+                recordShowdown(seats, 2, tally);
+            }
+            continue;
+        }
 
         // Compare results
-        if (playerValue > opponentValue)
+        for (int t = 0; t < blockTrials; ++t)
+        {
+            if (scores[2 * t] > scores[2 * t + 1])
+            {
+                tally.win++;
+                tally.equity += EQUITY_UNIT;
+            }
+            else if (scores[2 * t] < scores[2 * t + 1])
+            {
+                tally.lose++;
+            }
+            else
+            {
+                tally.tie++;
+                tally.equity += EQUITY_UNIT / 2;
+            }
+        }
+    }
+}
+
+template <class Cards>
+void MonteCarloSimulator::runOmahaTrials(Cards &deck, int trials, Tally &tally) const
+{
+    CardId playerIds[OmahaHandEvaluator::HOLE_CARDS];
+    for (int i = 0; i < OmahaHandEvaluator::HOLE_CARDS; ++i)
+        playerIds[i] = toCardId(playerHand[i]);
+
+    for (int t = 0; t < trials; ++t)
+    {
+        auto [opponentHand, completeBoard] = dealRandomOpponentAndBoard(deck);
+
+        CardId opponentIds[OmahaHandEvaluator::HOLE_CARDS];
+        int held = 0;
+        for (CardId id : opponentHand)
+            opponentIds[held++] = id;
+
+        CardId boardIds[5];
+        int boardSize = 0;
+        for (CardId id : completeBoard)
+            boardIds[boardSize++] = id;
+
+        // Both players share the board's split into 3-card subsets
+        OmahaHandEvaluator::Board board = OmahaHandEvaluator::Board::of(boardIds, boardSize);
+        if (isHiLo(variant))
         {
-            winCount++;
+            const HiLoScore seats[2] = {OmahaHandEvaluator::evaluateHiLo(board, playerIds),
+                                        OmahaHandEvaluator::evaluateHiLo(board, opponentIds)};
+            recordShowdown(seats, 2, tally);
+            continue;
         }
-        else if (opponentValue > playerValue)
+
+        uint32_t playerScore = OmahaHandEvaluator::evaluate(board, playerIds);
+        uint32_t opponentScore = OmahaHandEvaluator::evaluate(board, opponentIds);
+
+        if (playerScore > opponentScore)
         {
-            loseCount++;
+            tally.win++;
+            tally.equity += EQUITY_UNIT;
+        }
+        else if (playerScore < opponentScore)
+        {
+            tally.lose++;
         }
         else
         {
-            tieCount++;
+            tally.tie++;
+            tally.equity += EQUITY_UNIT / 2;
+        }
+    }
+}
+
+/**
+ * Several opponents: each trial completes the board and deals every
+ * opponent from the same partial shuffle, then scores all seats against
+ * that one board. Hold'em prepares the board once as a SharedBoard and
+ * Omaha as its 3-card subsets, so each extra seat costs a hole-card
+ * lookup, not a full evaluation.
+ */
+template <class Cards>
+void MonteCarloSimulator::runMultiwayTrials(Cards &deck, int trials, Tally &tally) const
+{
+    const int seats = opponents + 1;
+    const int holeCards = holeCardCount(variant);
+
+    // Seat 0 is the player
+    CardId holes[MAX_OPPONENTS + 1][OmahaHandEvaluator::HOLE_CARDS];
+    for (int i = 0; i < holeCards; ++i)
+        holes[0][i] = toCardId(playerHand[i]);
+
+    HiLoScore scores[MAX_OPPONENTS + 1];
+
+    for (int t = 0; t < trials; ++t)
+    {
+        deck.reset();
+        const CardSet board = knownBoard | deck.deal(5 - knownBoard.size());
+        for (int s = 1; s < seats; ++s)
+            for (int i = 0; i < holeCards; ++i)
+                holes[s][i] = deck.dealId();
+
+        const PreparedBoard prepared(variant, board);
+        for (int s = 0; s < seats; ++s)
+            scores[s] = prepared.score(holes[s]);
+
+        recordShowdown(scores, seats, tally);
+    }
+}
+
+/**
+ * Heads-up trials for the reduced estimators. Trial j plays stratum
+ * j mod strata: the stratum's opponent cards, then the rest of the
+ * opponent's hand and the runout drawn from what is left. As in
+ * runTrials, Hold'em and short deck hands are scored a block at a time.
+ * Each outcome and the player's final category go to its stratum's sums.
+ */
+void MonteCarloSimulator::runReducedTrials(Rng &rng, long long firstSample, int samples, Tally &tally) const
+{
+    const int BLOCK_SIZE = 256;
+    CardSet hands[2 * BLOCK_SIZE];
+    uint32_t scores[2 * BLOCK_SIZE];
+    HiLoScore seats[BLOCK_SIZE][2];
+    int strataOf[BLOCK_SIZE];
+
+    const int holeCards = holeCardCount(variant);
+    const int missing = 5 - knownBoard.size();
+    const int count = plan.liveCount;
+    const int strata = static_cast<int>(plan.strata.size());
+    const CardSet playerCards = CardSet::fromCards(playerHand);
+
+    CardId playerIds[OmahaHandEvaluator::HOLE_CARDS];
+    for (int i = 0; i < holeCards; ++i)
+        playerIds[i] = toCardId(playerHand[i]);
+
+    // Dealing swaps each card to the end of the undealt range, so putting
+    // them all back only resets the range
+    uint8_t order[52];
+    uint8_t where[52];
+    for (int i = 0; i < count; ++i)
+        order[i] = where[i] = static_cast<uint8_t>(i);
+    int remaining = count;
+    auto take = [&](int at) {
+        const int card = order[at];
+        const int last = order[--remaining];
+        order[at] = static_cast<uint8_t>(last);
+        where[last] = static_cast<uint8_t>(at);
+        order[remaining] = static_cast<uint8_t>(card);
+        where[card] = static_cast<uint8_t>(remaining);
+        return plan.live[card];
+    };
+
+    int stratum = static_cast<int>(firstSample % strata);
+    for (int done = 0; done < samples; done += BLOCK_SIZE)
+    {
+        const int blockTrials = std::min(BLOCK_SIZE, samples - done);
+
+        for (int t = 0; t < blockTrials; ++t)
+        {
+            remaining = count;
+            CardId opponentIds[OmahaHandEvaluator::HOLE_CARDS];
+            for (int i = 0; i < holeCards; ++i)
+                opponentIds[i] = i < plan.fixedCards ? take(where[plan.strata[stratum][i]])
+                                                     : take(static_cast<int>(rng.below(remaining)));
+            CardSet board = knownBoard;
+            for (int i = 0; i < missing; ++i)
+                board.add(take(static_cast<int>(rng.below(remaining))));
+
+            strataOf[t] = stratum;
+            if (++stratum == strata)
+                stratum = 0;
+
+            if (isOmaha(variant))
+            {
+                const PreparedBoard prepared(variant, board);
+                seats[t][0] = prepared.score(playerIds);
+                seats[t][1] = prepared.score(opponentIds);
+                continue;
+            }
+            hands[2 * t] = playerCards | board;
+            hands[2 * t + 1] = board | CardSet::of(opponentIds[0]) | CardSet::of(opponentIds[1]);
+        }
+
+        if (!isOmaha(variant))
+        {
+            scoreHands(hands, scores, 2 * blockTrials);
+            for (int i = 0; i < 2 * blockTrials; ++i)
+                seats[i / 2][i % 2] = {scores[i], isHiLo(variant) ? LowHandEvaluator::evaluate(hands[i])
+                                                                  : LowHandEvaluator::NO_LOW};
+        }
+
+        for (int t = 0; t < blockTrials; ++t)
+        {
+            // This trial's outcome is what recordShowdown adds to the tally
+            const long long wins = tally.win, ties = tally.tie, equity = tally.equity;
+            const long long scoops = tally.scoop, highOnly = tally.highOnly, lowOnly = tally.lowOnly;
+            recordShowdown(seats[t], 2, tally);
+
+            const long long win = tally.win - wins;
+            const long long tie = tally.tie - ties;
+            const long long share = tally.equity - equity;
+            const long long control = plan.control ? seats[t][0].high >> HandValue::CATEGORY_SHIFT : 0;
+
+            GroupSums &s = tally.groups[strataOf[t]];
+            s.samples++;
+            s.win += win;
+            s.tie += tie;
+            s.scoop += tally.scoop - scoops;
+            s.highOnly += tally.highOnly - highOnly;
+            s.lowOnly += tally.lowOnly - lowOnly;
+            s.equity += share;
+            s.control += control;
+            s.controlSquares += control * control;
+            s.winControl += win * control;
+            s.tieControl += tie * control;
+            s.equityControl += share * control;
         }
     }
 }
 
+/**
+ * Tally one showdown between the player (seat 0) and the other seats.
+ * The high half goes to the best high hand and the low half to the best
+ * qualifying low, each split evenly between tied seats; with no low at
+ * all, or outside Hi/Lo, the high hand takes the whole pot. Scoops and
+ * single halves are Hi/Lo outcomes and count only when the player wins
+ * them alone.
+ */
+void MonteCarloSimulator::recordShowdown(const HiLoScore *seats, int count, Tally &tally) const
+{
+    uint32_t bestHigh = 0, bestLow = LowHandEvaluator::NO_LOW;
+    for (int s = 0; s < count; ++s)
+    {
+        bestHigh = std::max(bestHigh, seats[s].high);
+        bestLow = std::max(bestLow, seats[s].low);
+    }
+
+    int highWinners = 0, lowWinners = 0;
+    for (int s = 0; s < count; ++s)
+    {
+        highWinners += seats[s].high == bestHigh;
+        lowWinners += seats[s].low == bestLow;
+    }
+
+    const bool lowPlays = bestLow != LowHandEvaluator::NO_LOW;
+    const bool playerHigh = seats[0].high == bestHigh;
+    const bool playerLow = lowPlays && seats[0].low == bestLow;
+
+    int share = 0;
+    if (lowPlays)
+    {
+        share += playerHigh ? EQUITY_UNIT / 2 / highWinners : 0;
+        share += playerLow ? EQUITY_UNIT / 2 / lowWinners : 0;
+    }
+    else
+    {
+        share = playerHigh ? EQUITY_UNIT / highWinners : 0;
+    }
+    tally.equity += share;
+
+    // Hi/Lo compares the share with an even split of the pot
+    if (isHiLo(variant))
+    {
+        const bool soleHigh = playerHigh && highWinners == 1;
+        const bool soleLow = playerLow && lowWinners == 1;
+        if (soleHigh && (soleLow || !lowPlays))
+            tally.scoop++;
+        else if (soleHigh)
+            tally.highOnly++;
+        else if (soleLow)
+            tally.lowOnly++;
+
+        if (share * count > EQUITY_UNIT)
+            tally.win++;
+        else if (share * count < EQUITY_UNIT)
+            tally.lose++;
+        else
+            tally.tie++;
+    }
+    else if (!playerHigh)
+        tally.lose++;
+    else if (highWinners == 1)
+        tally.win++;
+    else
+        tally.tie++;
+}
+
+double MonteCarloSimulator::getEquity() const
+{
+    return result.equity;
+}
+
+double MonteCarloSimulator::getScoopPercentage() const
+{
+    return result.scoop;
+}
+
+double MonteCarloSimulator::getHighOnlyPercentage() const
+{
+    return result.highOnly;
+}
+
+double MonteCarloSimulator::getLowOnlyPercentage() const
+{
+    return result.lowOnly;
+}
+
 double MonteCarloSimulator::getWinPercentage() const
 {
-    if (numSimulations == 0)
-        return 0.0;
-    return static_cast<double>(winCount) / numSimulations;
+    return result.win;
 }
 
 double MonteCarloSimulator::getTiePercentage() const
 {
-    if (numSimulations == 0)
-        return 0.0;
-    return static_cast<double>(tieCount) / numSimulations;
+    return result.tie;
 }
 
 double MonteCarloSimulator::getLosePercentage() const
 {
-    if (numSimulations == 0)
-        return 0.0;
-    return static_cast<double>(loseCount) / numSimulations;
+    return result.lose;
 }
 
-// Calculate standard deviation of win rate using binomial distribution
-// For binary outcomes: σ = sqrt(p(1-p)/n)
+// Standard deviation of the win rate: σ = sqrt(p(1-p)/n) for plain
+// sampling, from the residuals with variance reduction, zero for an exact run
 double MonteCarloSimulator::getWinRateStdDev() const
 {
-    if (numSimulations == 0)
-        return 0.0;
-    
-    double p = getWinPercentage();
-    double variance = p * (1.0 - p) / numSimulations;
-    return std::sqrt(variance);
+    return std::sqrt(result.winVariance);
+}
+
+double MonteCarloSimulator::getEffectiveSampleSize() const
+{
+    return result.effectiveSamples;
 }
 
 // Calculate confidence interval for win rate
@@ -103,24 +943,14 @@ double MonteCarloSimulator::getWinRateStdDev() const
 // Uses normal approximation for binomial: mean ± z * σ
 std::pair<double, double> MonteCarloSimulator::getConfidenceInterval(double confidence) const
 {
-    if (numSimulations == 0)
+    if (trialCount == 0)
         return {0.0, 0.0};
     
     double winRate = getWinPercentage();
     double stdDev = getWinRateStdDev();
     
-    // Z-scores for common confidence levels
-    // 95% = 1.96, 99% = 2.576, 90% = 1.645
-    double z = 1.96;  // Default to 95% confidence
-    
-    if (confidence >= 0.99)
-        z = 2.576;
-    else if (confidence >= 0.95)
-        z = 1.96;
-    else if (confidence >= 0.90)
-        z = 1.645;
-    
-    double margin = z * stdDev;
+    // Two-sided: the upper quantile at 1 - (1 - confidence) / 2
+    double margin = PokerMath::zScore(confidence) * stdDev;
     double lowerBound = std::max(0.0, winRate - margin);
     double upperBound = std::min(1.0, winRate + margin);
     
@@ -129,43 +959,25 @@ std::pair<double, double> MonteCarloSimulator::getConfidenceInterval(double conf
 
 double MonteCarloSimulator::getFlushDrawOdds() const
 {
-    // Count cards by suit
-    std::map<Suit, int> suitCount;
-    for (const Card &c : playerHand)
-    {
-        suitCount[c.suit]++;
-    }
-    for (const Card &c : communityCards)
-    {
-        suitCount[c.suit]++;
-    }
-
     // Check if we have 4 cards of the same suit
-    Suit flushSuit = Suit::Clubs; // Default
-    bool hasFlushDraw = false;
-
-    for (const auto &[suit, count] : suitCount)
+    int flushSuit = -1;
+    for (int suit = 0; suit < 4 && flushSuit < 0; ++suit)
     {
-        if (count == 4)
-        {
-            hasFlushDraw = true;
+        if (__builtin_popcount(deadCards.suitMask(suit)) == 4)
             flushSuit = suit;
-            break;
-        }
     }
 
-    if (!hasFlushDraw)
+    if (flushSuit < 0)
     {
         return 0.0;
     }
 
     // Calculate how many flush cards are left in the deck
-    int totalCards = playerHand.size() + communityCards.size();
-    int cardsRemaining = 13 - suitCount[flushSuit]; // 13 cards per suit
-    int deckSize = 52 - totalCards;
+    CardSet unseen = CardSet::fullDeck(lowestRank(variant)).without(deadCards);
+    int cardsRemaining = __builtin_popcount(unseen.suitMask(flushSuit));
 
     // Probability of drawing a flush card
-    return static_cast<double>(cardsRemaining) / deckSize;
+    return static_cast<double>(cardsRemaining) / unseen.size();
 }
 
 double MonteCarloSimulator::getStraightDrawOdds() const
@@ -195,8 +1007,8 @@ double MonteCarloSimulator::getStraightDrawOdds() const
             ranks[i + 3] == ranks[i] + 1)
         {
             // Open-ended: we need the card before or after
-            if (ranks[i] - 1 >= 2)
-            { // 2 is the lowest card
+            if (ranks[i] - 1 >= lowestRank(variant))
+            { // no card below the deck's lowest rank
                 neededCards.push_back(ranks[i] - 1);
             }
             if (ranks[i + 3] + 1 <= 14)
@@ -228,93 +1040,42 @@ double MonteCarloSimulator::getStraightDrawOdds() const
         return 0.0;
     }
 
-    int totalCards = playerHand.size() + communityCards.size();
-    int deckSize = 52 - totalCards;
-
-    // Each rank has 4 cards (one per suit)
-    int totalOuts = neededCards.size() * 4;
-
-    // Subtract cards we already know
-    for (const Card &c : playerHand)
+    // Outs are the unseen cards of every needed rank, in all four suits
+    uint32_t neededRanks = 0;
+    for (int rank : neededCards)
     {
-        if (std::find(neededCards.begin(), neededCards.end(), static_cast<int>(c.rank)) != neededCards.end())
-        {
-            totalOuts--;
-    }
+        neededRanks |= 1u << (rank - 2);
     }
-    for (const Card &c : communityCards)
+
+    CardSet unseen = CardSet::fullDeck(lowestRank(variant)).without(deadCards);
+    int deckSize = unseen.size();
+    int totalOuts = 0;
+    for (int suit = 0; suit < 4; ++suit)
     {
-        if (std::find(neededCards.begin(), neededCards.end(), static_cast<int>(c.rank)) != neededCards.end())
-        {
-            totalOuts--;
-        }
+        totalOuts += __builtin_popcount(unseen.suitMask(suit) & neededRanks);
     }
 
     return static_cast<double>(totalOuts) / deckSize;
 }
 
-std::vector<Card> MonteCarloSimulator::getRemainingDeck() const
+/**
+ * The cards still to come: this variant's deck without the cards in play,
+ * dealing from `stream`
+ */
+Deck MonteCarloSimulator::getRemainingDeck(const Rng &stream) const
 {
-    std::vector<Card> deck;
-
-    // Create a full deck
-    for (int s = 0; s < 4; ++s)
-    {
-        for (int r = 2; r <= 14; ++r)
-        {
-            Card card(static_cast<Rank>(r), static_cast<Suit>(s));
-
-            // Check if card is already in player hand or community cards
-            bool isUsed = false;
-            for (const Card &c : playerHand)
-            {
-                if (c.rank == card.rank && c.suit == card.suit)
-                {
-                    isUsed = true;
-                    break;
-                }
-            }
-
-            if (!isUsed)
-            {
-                for (const Card &c : communityCards)
-                {
-                    if (c.rank == card.rank && c.suit == card.suit)
-                    {
-                        isUsed = true;
-                        break;
-                    }
-                }
-            }
-
-            if (!isUsed)
-            {
-                deck.push_back(card);
-            }
-        }
-    }
-
-    return deck;
+    return Deck(variant, deadCards, stream);
 }
 
-std::pair<std::vector<Card>, std::vector<Card>> MonteCarloSimulator::dealRandomOpponentAndBoard(
-    const std::vector<Card> &deck) const
+/**
+ * Return every card to the deck and deal the opponent's hole cards (two in
+ * Hold'em, four in Omaha) and whatever the board still needs
+ */
+template <class Cards>
+std::pair<CardSet, CardSet> MonteCarloSimulator::dealRandomOpponentAndBoard(Cards &deck) const
 {
-    std::vector<Card> opponentHand;
-    std::vector<Card> completeBoard = communityCards;
-
-    // Deal opponent's two cards if they don't already have them
-    size_t index = 0;
-    while (opponentHand.size() < 2 && index < deck.size())
-    {
-        opponentHand.push_back(deck[index++]);
-    }
-
-    // Complete the board to 5 cards if needed
-    while (completeBoard.size() < 5 && index < deck.size())
-    {
-        completeBoard.push_back(deck[index++]);
-    }
-
+    deck.reset();
+    CardSet opponentHand = deck.deal(holeCardCount(variant));
+    CardSet completeBoard = knownBoard | deck.deal(5 - knownBoard.size());
     return {opponentHand, completeBoard};
-}
\ No newline at end of file
+}
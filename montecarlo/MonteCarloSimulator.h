@@ -2,41 +2,272 @@
 #define MONTE_CARLO_SIMULATOR_H
 
 #include "../model/card.h"
+#include "../model/card_set.h"
+#include "../model/deck.h"
+#include "../model/game_variant.h"
+#include "../model/low_hand_evaluator.h"
+#include "../model/rng.h"
+#include <array>
+#include <cstdint>
 #include <vector>
 #include <utility>  // for std::pair
 
 class MonteCarloSimulator
 {
 public:
+    static constexpr int MAX_OPPONENTS = 9;
+
+    // Sample random trials, enumerate every outcome, or pick whichever is cheaper
+    enum class Mode
+    {
+        Auto,
+        Sample,
+        Exact
+    };
+
+    // `opponents` random hands (1 to MAX_OPPONENTS) play against the player
     MonteCarloSimulator(const std::vector<Card> &playerHand,
                         const std::vector<Card> &communityCards,
-                        int simulations = 10000);
+                        int simulations = 10000,
+                        GameVariant variant = GameVariant::Holdem,
+                        int opponents = 1);
 
+    /**
+     * Deal and score every trial. Trials are split into fixed chunks that
+     * run on WorkStealingPool::shared(); chunk c always deals from the same
+     * stream of the seed, so the counts depend only on the seed, never on
+     * the thread count or on which worker ran which chunk.
+     *
+     * In exact mode every runout of the board is paired with every
+     * opponent holding instead, giving the true percentages. Auto (the
+     * default) enumerates when that takes no more showdowns than the
+     * requested number of simulations, which is common on the turn and
+     * river heads-up.
+     */
     void runSimulation();
+
+    // Exact mode needs a single opponent
+    void setMode(Mode value) { mode = value; }
+    bool isExact() const { return exact; }
+
+    // Showdowns an exact run scores: board runouts times opponent holdings
+    uint64_t exactCombinations() const;
+
+    static constexpr double NO_THRESHOLD = -1.0;
+
+    // Trials per chunk, the unit of work handed to the pool, unless a
+    // stopping rule asks for smaller rounds
+    static constexpr int CHUNK_TRIALS = 1024;
+
+    /**
+     * Sample only until the win-rate interval at `confidence` is within
+     * ±halfWidth, or lies wholly above or below `threshold` (the win rate
+     * a decision turns on). The simulation count becomes a budget.
+     *
+     * Trials run in rounds of 1, 2, 4, ... chunks with a look after each.
+     * The error rate is spent across the looks, half at the first, a
+     * quarter at the second and so on, so stopping at whichever look
+     * comes out tight still leaves the interval at `confidence`. Rounds
+     * are whole chunks, so the stopping point depends only on the seed.
+     * `firstRound` (at most CHUNK_TRIALS) sets the chunk size, so an easy
+     * spot can stop after that many trials.
+     */
+    void setStoppingRule(double halfWidth, double threshold = NO_THRESHOLD, double confidence = 0.95,
+                         int firstRound = CHUNK_TRIALS);
+    void clearStoppingRule()
+    {
+        targetHalfWidth = 0.0;
+        chunkTrials = CHUNK_TRIALS;
+    }
+
+    /**
+     * Variance reduction for heads-up sampling. Both techniques keep the
+     * estimates unbiased and narrow getWinRateStdDev for the same number
+     * of showdowns; getEffectiveSampleSize tells how many plain trials
+     * the run was worth.
+     *
+     * stratified: trial j deals the opponent holding j mod C(live, 2)
+     *     (Omaha: the first hole card j mod live) and draws the rest, so
+     *     every holding is played equally often.
+     * controlVariate: corrects each rate by its regression on the
+     *     category of the player's final hand, whose exact mean comes
+     *     from scoring the player on every runout (one or two cards to
+     *     come, when that is cheap next to the budget).
+     *
+     * More than one opponent always samples plainly.
+     */
+    struct VarianceReduction
+    {
+        bool stratified = false;
+        bool controlVariate = false;
+
+        static VarianceReduction all() { return {true, true}; }
+    };
+
+    void setVarianceReduction(VarianceReduction value) { reduction = value; }
+
+    /**
+     * Where plain sampling gets its deals. QuasiRandom deals from the
+     * points of a KroneckerDeck instead of the PRNG, in up to REPLICATES
+     * independently shifted replicates whose spread gives the error
+     * (getWinRateStdDev, getEffectiveSampleSize). Chunk c continues
+     * replicate c mod R, so results still depend only on the seed.
+     * Reduced sampling always uses the PRNG.
+     */
+    enum class Sampler
+    {
+        Random,
+        QuasiRandom
+    };
+
+    static constexpr int REPLICATES = 16;
+
+    void setSampler(Sampler value) { sampler = value; }
+
+    // Seed of the next run; defaults to a draw from Rng::nextStream()
+    void setSeed(uint64_t value) { seed = value; }
+    uint64_t getSeed() const { return seed; }
+
+    // Workers to run on, 0 (the default) for every hardware thread
+    void setThreadCount(unsigned threads) { threadCount = threads; }
+
+    int getOpponentCount() const { return opponents; }
+
+    // Win: the player alone has the best hand (Hi/Lo: more than an even
+    // share of the pot); tie: shares the best hand (an even share)
     double getWinPercentage() const;
     double getTiePercentage() const;
     double getLosePercentage() const;
-    
-    // Statistical rigor methods
+
+    // Average share of the pot won; a k-way split counts 1/k
+    double getEquity() const;
+
+    // Statistical rigor methods; an exact run has no sampling error
     double getWinRateStdDev() const;  // Standard deviation of win rate
+    double getEffectiveSampleSize() const; // plain trials with the same standard deviation
     std::pair<double, double> getConfidenceInterval(double confidence = 0.95) const;
-    int getSampleSize() const { return numSimulations; }
+    long long getSampleSize() const { return trialCount; } // showdowns behind the last run
+
+    // Hi/Lo outcomes: both halves (or high with no qualifying low), high only, low only
+    double getScoopPercentage() const;
+    double getHighOnlyPercentage() const;
+    double getLowOnlyPercentage() const;
 
     // Drawing hand probability methods
     double getFlushDrawOdds() const;
     double getStraightDrawOdds() const;
 
 private:
+
+    // Pot shares are counted in units of 1/EQUITY_UNIT of a pot, which
+    // divides evenly between up to ten players, or half of it between
+    // ten, so the totals stay exact integers
+    static constexpr int EQUITY_UNIT = 5040;
+
+    // Sums over the trials of one stratum or replicate
+    struct GroupSums
+    {
+        long long samples = 0;
+        long long win = 0;
+        long long tie = 0;
+        long long scoop = 0;
+        long long highOnly = 0;
+        long long lowOnly = 0;
+        long long equity = 0;
+        long long control = 0;
+        long long controlSquares = 0;
+        long long winControl = 0;
+        long long tieControl = 0;
+        long long equityControl = 0;
+
+        GroupSums &operator+=(const GroupSums &other);
+    };
+
+    // Outcome counts of some trials; one per worker, each on its own cache line
+    struct alignas(64) Tally
+    {
+        long long win = 0;
+        long long tie = 0;
+        long long lose = 0;
+        long long scoop = 0;
+        long long highOnly = 0;
+        long long lowOnly = 0;
+        long long equity = 0; // in EQUITY_UNITs
+        std::vector<GroupSums> groups; // per stratum, or per replicate for quasi-random runs
+
+        Tally &operator+=(const Tally &other);
+    };
+
+    // How a sampled run deals: the reduced estimators' strata and control
+    // means, or the quasi-random replicates' shifts
+    struct SamplingPlan
+    {
+        bool reduced = false;
+        bool control = false;
+        int fixedCards = 0;              // opponent cards each stratum fixes
+        int liveCount = 0;
+        CardId live[52];
+        std::vector<std::array<uint8_t, 2>> strata; // positions in live of the fixed cards
+        std::vector<double> controlMean; // exact mean control per stratum
+
+        bool quasi = false;
+        int replicates = 0;
+        int dimensions = 0;              // cards dealt per trial
+        std::vector<uint64_t> shifts;    // `dimensions` words per replicate
+    };
+
+    // Probabilities a run estimates
+    struct Estimate
+    {
+        double win = 0.0;
+        double tie = 0.0;
+        double lose = 0.0;
+        double scoop = 0.0;
+        double highOnly = 0.0;
+        double lowOnly = 0.0;
+        double equity = 0.0;
+        double winVariance = 0.0;      // of the win estimate
+        double effectiveSamples = 0.0;
+    };
+
     std::vector<Card> playerHand;
     std::vector<Card> communityCards;
+    CardSet knownBoard; // community cards dealt so far
+    CardSet deadCards;  // player and community cards, never dealt
     int numSimulations;
-    int winCount;
-    int tieCount;
-    int loseCount;
+    GameVariant variant;
+    Estimate result;
+    long long trialCount = 0;
+    int opponents;
+    uint64_t seed;
+    unsigned threadCount = 0;
+    Mode mode = Mode::Auto;
+    bool exact = false;
+    VarianceReduction reduction;
+    Sampler sampler = Sampler::Random;
+    SamplingPlan plan;
+    double targetHalfWidth = 0.0; // 0: run the whole budget
+    double decisionThreshold = NO_THRESHOLD;
+    double stopConfidence = 0.95;
+    int chunkTrials = CHUNK_TRIALS;
+
+    void runSampled(std::vector<Tally> &tallies);
+    void runExact(std::vector<Tally> &tallies);
+    bool intervalSettled(const Tally &total, double z) const;
+    void planSampling();
+    Estimate estimateOf(const Tally &total) const;
+
+    void scoreHands(const CardSet *hands, uint32_t *scores, int count) const;
 
-    std::vector<Card> getRemainingDeck() const;
-    std::pair<std::vector<Card>, std::vector<Card>> dealRandomOpponentAndBoard(const std::vector<Card> &deck) const;
-    int evaluateHand(const std::vector<Card> &hand, const std::vector<Card> &board) const;
+    // `Cards` is a Deck or a KroneckerDeck
+    template <class Cards> void dealTrials(Cards &deck, int trials, Tally &tally) const;
+    template <class Cards> void runTrials(Cards &deck, int trials, Tally &tally) const;
+    template <class Cards> void runOmahaTrials(Cards &deck, int trials, Tally &tally) const;
+    template <class Cards> void runMultiwayTrials(Cards &deck, int trials, Tally &tally) const;
+    void runReducedTrials(Rng &rng, long long firstSample, int samples, Tally &tally) const;
+    void recordShowdown(const HiLoScore *seats, int count, Tally &tally) const;
+    Deck getRemainingDeck(const Rng &stream) const;
+    template <class Cards> std::pair<CardSet, CardSet> dealRandomOpponentAndBoard(Cards &deck) const;
 };
 
 #endif
\ No newline at end of file
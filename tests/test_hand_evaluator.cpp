@@ -5,10 +5,26 @@
  */
 
 #include "../model/advanced_hand_evaluator.h"
+#include "../model/batch_hand_evaluator.h"
+#include "../model/bitmask_hand_evaluator.h"
+#include "../model/lookup_table_evaluator.h"
+#include "../model/low_hand_evaluator.h"
 #include "../model/card.h"
+#include "../model/combinatorics.h"
+#include "../model/eval_state.h"
+#include "../model/hand_indexer.h"
+#include "../model/evaluator_registry.h"
+#include "../model/omaha_hand_evaluator.h"
+#include "../model/short_deck_evaluator.h"
 #include <iostream>
+#include <array>
 #include <vector>
 #include <cassert>
+#include <random>
+#include <stdexcept>
+#include <algorithm>
+#include <cstdio>
+#include <string>
 
 #define TEST(name) void test_##name()
 #define RUN_TEST(name) do { \
@@ -208,6 +224,716 @@ TEST(kicker_comparison) {
     ASSERT_TRUE(hv1 > hv2);
 }
 
+// Test: With six to a straight the highest run plays
+TEST(highest_straight_plays) {
+    std::vector<Card> hand = {
+        Card(Rank::Ace, Suit::Hearts),
+        Card(Rank::Two, Suit::Diamonds),
+        Card(Rank::Three, Suit::Clubs),
+        Card(Rank::Four, Suit::Spades),
+        Card(Rank::Five, Suit::Hearts),
+        Card(Rank::Six, Suit::Clubs),
+        Card(Rank::King, Suit::Diamonds)
+    };
+    
+    HandValue hv = AdvancedHandEvaluator::evaluate(hand);
+    ASSERT_EQ(hv.rank, HandRank::Straight);
+    ASSERT_EQ(hv.kicker(0), 6);
+    ASSERT_EQ(AdvancedHandEvaluator::evaluateReference(hand).kicker(0), 6);
+}
+
+// Test: A pair can be the kicker to four of a kind
+TEST(quads_kicker_from_pair) {
+    std::vector<Card> hand = {
+        Card(Rank::Nine, Suit::Hearts),
+        Card(Rank::Nine, Suit::Diamonds),
+        Card(Rank::Nine, Suit::Clubs),
+        Card(Rank::Nine, Suit::Spades),
+        Card(Rank::King, Suit::Hearts),
+        Card(Rank::King, Suit::Clubs),
+        Card(Rank::Three, Suit::Diamonds)
+    };
+    
+    HandValue hv = AdvancedHandEvaluator::evaluate(hand);
+    ASSERT_EQ(hv.rank, HandRank::FourOfAKind);
+    ASSERT_EQ(hv.kicker(1), 13);
+    ASSERT_TRUE(hv == AdvancedHandEvaluator::evaluateReference(hand));
+}
+
+static std::vector<Card> randomHand(std::mt19937 &rng, size_t size) {
+    std::vector<Card> deck;
+    for (int s = 0; s < 4; ++s)
+        for (int r = 2; r <= 14; ++r)
+            deck.emplace_back(static_cast<Rank>(r), static_cast<Suit>(s));
+    std::shuffle(deck.begin(), deck.end(), rng);
+    deck.erase(deck.begin() + size, deck.end());
+    return deck;
+}
+
+// Test: Bitmask evaluator agrees with the reference evaluator
+TEST(bitmask_matches_reference) {
+    std::mt19937 rng(12345);
+    for (size_t size = 5; size <= 7; ++size) {
+        for (int i = 0; i < 20000; ++i) {
+            std::vector<Card> hand = randomHand(rng, size);
+            HandValue expected = AdvancedHandEvaluator::evaluateReference(hand);
+            uint32_t score = BitmaskHandEvaluator::evaluate(CardSet::fromCards(hand));
+            ASSERT_TRUE(HandValue::fromScore(score) == expected);
+        }
+    }
+}
+
+// Test: Packed scores order hands the same way HandValue does
+TEST(packed_score_ordering) {
+    std::mt19937 rng(777);
+    for (int i = 0; i < 20000; ++i) {
+        std::vector<Card> a = randomHand(rng, 7);
+        std::vector<Card> b = randomHand(rng, 7);
+        HandValue hvA = AdvancedHandEvaluator::evaluateReference(a);
+        HandValue hvB = AdvancedHandEvaluator::evaluateReference(b);
+        uint32_t scoreA = BitmaskHandEvaluator::evaluate(CardSet::fromCards(a));
+        uint32_t scoreB = BitmaskHandEvaluator::evaluate(CardSet::fromCards(b));
+        ASSERT_EQ(hvA > hvB, scoreA > scoreB);
+        ASSERT_EQ(hvA == hvB, scoreA == scoreB);
+    }
+}
+
+// Test: HandValue exposes rank and kickers from the packed score
+TEST(packed_hand_value_view) {
+    std::vector<Card> hand = {
+        Card(Rank::Queen, Suit::Hearts),
+        Card(Rank::Queen, Suit::Diamonds),
+        Card(Rank::Queen, Suit::Clubs),
+        Card(Rank::Seven, Suit::Hearts),
+        Card(Rank::Seven, Suit::Spades),
+        Card(Rank::Two, Suit::Diamonds)
+    };
+    
+    HandValue hv = AdvancedHandEvaluator::evaluate(hand);
+    ASSERT_EQ(hv.rank, HandRank::FullHouse);
+    ASSERT_EQ(hv.kickerCount(), 2);
+    ASSERT_EQ(hv.kicker(0), 12);
+    ASSERT_EQ(hv.kicker(1), 7);
+    ASSERT_EQ(hv.kicker(2), 0);
+    ASSERT_TRUE(HandValue::fromScore(hv.score) == hv);
+    static_assert(sizeof(HandValue) == 8, "HandValue should stay two words");
+}
+
+// Test: Every batch kernel agrees with the scalar evaluator
+TEST(batch_kernels_match_scalar) {
+    std::mt19937 rng(99);
+    std::vector<CardSet> hands;
+    for (int i = 0; i < 30001; ++i)  // not a multiple of 8 or 16: exercises the tails
+        hands.push_back(CardSet::fromCards(randomHand(rng, 5 + i % 3)));
+
+    std::vector<uint32_t> expected(hands.size());
+    for (size_t i = 0; i < hands.size(); ++i)
+        expected[i] = BitmaskHandEvaluator::evaluate(hands[i]);
+
+    std::vector<uint32_t> out(hands.size());
+    AdvancedHandEvaluator::evaluateBatch(hands.data(), out.data(), out.size());
+    ASSERT_TRUE(out == expected);
+
+    if (BatchHandEvaluator::avx2Supported()) {
+        std::fill(out.begin(), out.end(), 0);
+        BatchHandEvaluator::evaluateAvx2(hands.data(), out.data(), out.size());
+        ASSERT_TRUE(out == expected);
+    }
+    if (BatchHandEvaluator::avx512Supported()) {
+        std::fill(out.begin(), out.end(), 0);
+        BatchHandEvaluator::evaluateAvx512(hands.data(), out.data(), out.size());
+        ASSERT_TRUE(out == expected);
+    }
+}
+
+// Test: Adding cards one at a time matches evaluating them all at once
+TEST(eval_state_matches_bitmask) {
+    std::mt19937 rng(2024);
+    for (int i = 0; i < 20000; ++i) {
+        std::vector<Card> hand = randomHand(rng, 7);
+        EvalState state;
+        for (size_t n = 0; n < hand.size(); ++n) {
+            state.add(hand[n]);
+            ASSERT_EQ(state.size(), static_cast<int>(n + 1));
+            if (n + 1 >= 5) {
+                std::vector<Card> prefix(hand.begin(), hand.begin() + n + 1);
+                ASSERT_EQ(state.score(), BitmaskHandEvaluator::evaluate(CardSet::fromCards(prefix)));
+            }
+        }
+    }
+}
+
+// Test: Branching with with() leaves the original state untouched
+TEST(eval_state_branching) {
+    std::vector<Card> flop = {
+        Card(Rank::Ace, Suit::Hearts),
+        Card(Rank::King, Suit::Hearts),
+        Card(Rank::Queen, Suit::Hearts),
+        Card(Rank::Jack, Suit::Hearts),
+        Card(Rank::Two, Suit::Clubs)
+    };
+    EvalState state = EvalState::of(flop);
+    ASSERT_EQ(state.category(), HandRank::HighCard);
+
+    EvalState royal = state.with(toCardId(Card(Rank::Ten, Suit::Hearts)));
+    EvalState pair = state.with(toCardId(Card(Rank::Two, Suit::Spades)));
+    ASSERT_EQ(royal.category(), HandRank::RoyalFlush);
+    ASSERT_EQ(pair.category(), HandRank::OnePair);
+    ASSERT_EQ(state.category(), HandRank::HighCard);
+    ASSERT_EQ(state.size(), 5);
+    ASSERT_TRUE(royal.contains(toCardId(Card(Rank::Ten, Suit::Hearts))));
+    ASSERT_TRUE(!state.contains(toCardId(Card(Rank::Ten, Suit::Hearts))));
+}
+
+template <size_t N>
+static std::array<CardId, N> toIds(const std::vector<Card> &hand) {
+    std::array<CardId, N> ids{};
+    for (size_t i = 0; i < N; ++i)
+        ids[i] = toCardId(hand[i]);
+    return ids;
+}
+
+// Test: evaluate<N> agrees with the bitmask evaluator for every size
+TEST(fixed_size_matches_bitmask) {
+    std::mt19937 rng(4242);
+    for (int i = 0; i < 20000; ++i) {
+        std::vector<Card> hand = randomHand(rng, 7);
+        std::vector<Card> five(hand.begin(), hand.begin() + 5);
+        std::vector<Card> six(hand.begin(), hand.begin() + 6);
+        ASSERT_EQ(AdvancedHandEvaluator::evaluate(toIds<5>(hand)).score,
+                  BitmaskHandEvaluator::evaluate(CardSet::fromCards(five)));
+        ASSERT_EQ(AdvancedHandEvaluator::evaluate(toIds<6>(hand)).score,
+                  BitmaskHandEvaluator::evaluate(CardSet::fromCards(six)));
+        ASSERT_EQ(AdvancedHandEvaluator::evaluate(toIds<7>(hand)).score,
+                  BitmaskHandEvaluator::evaluate(CardSet::fromCards(hand)));
+    }
+
+    // Evaluated by the compiler: A-K-Q-J-T of the first suit, and a wheel
+    constexpr std::array<CardId, 5> royal = {12, 11, 10, 9, 8};
+    constexpr std::array<CardId, 6> wheel = {12, 13, 27, 41, 3, 20};
+    static_assert(AdvancedHandEvaluator::evaluate(royal).rank == HandRank::RoyalFlush, "royal flush");
+    static_assert(AdvancedHandEvaluator::evaluate(wheel).rank == HandRank::Straight, "wheel straight");
+    static_assert(AdvancedHandEvaluator::evaluate(wheel).kicker(0) == 5, "wheel plays to the Five");
+}
+
+// Test: Every usable registry backend scores like the bitmask evaluator
+TEST(registry_backends_agree) {
+    std::mt19937 rng(808);
+    std::vector<CardSet> hands;
+    for (int i = 0; i < 10001; ++i)
+        hands.push_back(CardSet::fromCards(randomHand(rng, 5 + i % 3)));
+
+    std::vector<uint32_t> expected(hands.size());
+    for (size_t i = 0; i < hands.size(); ++i)
+        expected[i] = BitmaskHandEvaluator::evaluate(hands[i]);
+
+    std::vector<const EvaluatorBackend *> backends = EvaluatorRegistry::available();
+    ASSERT_TRUE(!backends.empty());
+    ASSERT_EQ(std::string(backends[0]->name()), std::string("scalar"));
+    for (const EvaluatorBackend *backend : backends) {
+        std::vector<uint32_t> out(hands.size());
+        backend->evaluateBatch(hands.data(), out.data(), out.size());
+        ASSERT_TRUE(out == expected);
+        for (size_t i = 0; i < hands.size(); i += 97)
+            ASSERT_EQ(backend->evaluate(hands[i]), expected[i]);
+    }
+
+    ASSERT_TRUE(EvaluatorRegistry::find("scalar") != nullptr);
+    ASSERT_TRUE(EvaluatorRegistry::find("no-such-evaluator") == nullptr);
+    ASSERT_TRUE(EvaluatorRegistry::active().supported());
+}
+
+// Test: Omaha evaluator matches trying all 60 two-plus-three hands
+TEST(omaha_matches_brute_force) {
+    std::mt19937 rng(31337);
+    for (int i = 0; i < 5000; ++i) {
+        size_t boardSize = 3 + i % 3;
+        std::vector<Card> cards = randomHand(rng, 4 + boardSize);
+        std::vector<Card> hole(cards.begin(), cards.begin() + 4);
+        std::vector<Card> board(cards.begin() + 4, cards.end());
+
+        uint32_t expected = 0;
+        for (CardSet two : SubsetRange(CardSet::fromCards(hole), 2))
+            for (CardSet three : SubsetRange(CardSet::fromCards(board), 3))
+                expected = std::max(expected, AdvancedHandEvaluator::evaluate((two | three).toCards()).score);
+        ASSERT_EQ(OmahaHandEvaluator::evaluate(hole, board).score, expected);
+    }
+}
+
+// Test: Omaha plays exactly two hole cards, so one suited card is no flush
+TEST(omaha_exactly_two_hole_cards) {
+    std::vector<Card> hole = {
+        Card(Rank::Ace, Suit::Hearts),
+        Card(Rank::King, Suit::Clubs),
+        Card(Rank::Seven, Suit::Spades),
+        Card(Rank::Two, Suit::Diamonds)
+    };
+    std::vector<Card> board = {
+        Card(Rank::Nine, Suit::Hearts),
+        Card(Rank::Six, Suit::Hearts),
+        Card(Rank::Four, Suit::Hearts),
+        Card(Rank::Three, Suit::Hearts),
+        Card(Rank::Jack, Suit::Clubs)
+    };
+
+    HandValue hv = OmahaHandEvaluator::evaluate(hole, board);
+    ASSERT_EQ(hv.rank, HandRank::HighCard);
+    ASSERT_EQ(AdvancedHandEvaluator::evaluate(std::vector<Card>{hole[0], hole[1], board[0], board[1], board[2], board[3], board[4]}).rank,
+              HandRank::Flush);
+}
+
+// Test: CardSet membership, size and iteration agree with CardIds
+TEST(card_set_operations) {
+    CardSet deck = CardSet::fullDeck();
+    ASSERT_EQ(deck.size(), 52);
+    ASSERT_EQ(CardSet::fullDeck(6).size(), 36);
+    ASSERT_TRUE(!CardSet::fullDeck(6).contains(Card(Rank::Five, Suit::Spades)));
+
+    int expected = 0;
+    for (CardId id : deck) {
+        ASSERT_EQ(id, expected++);
+        ASSERT_EQ(toCardId(cardOf(id)), id);
+        ASSERT_TRUE(deck.contains(cardOf(id)));
+    }
+    ASSERT_EQ(expected, 52);
+
+    CardSet dead;
+    dead.add(Card(Rank::Ace, Suit::Spades));
+    dead.add(toCardId(Card(Rank::Two, Suit::Hearts)));
+    CardSet live = deck.without(dead);
+    ASSERT_EQ(live.size(), 50);
+    ASSERT_TRUE(!live.contains(Card(Rank::Ace, Suit::Spades)));
+    ASSERT_TRUE(!live.intersects(dead));
+    ASSERT_EQ(live | dead, deck);
+
+    live.remove(toCardId(Card(Rank::King, Suit::Clubs)));
+    ASSERT_EQ(live.size(), 49);
+    ASSERT_EQ(dead.toCards().size(), 2u);
+    ASSERT_TRUE(dead.toCards()[0] == Card(Rank::Two, Suit::Hearts));
+}
+
+// Test: CardList keeps deal order inline; CardSpan reads lists and vectors alike
+TEST(card_list_views) {
+    std::mt19937 rng(19);
+    std::vector<Card> cards = randomHand(rng, 7);
+
+    FullHand hand;
+    for (const Card &c : cards)
+        hand.push_back(c);
+    ASSERT_EQ(hand.size(), 7u);
+    for (size_t i = 0; i < cards.size(); ++i)
+        ASSERT_TRUE(hand[i] == cards[i]);
+
+    CardSpan fromList = hand;
+    CardSpan fromVector = cards;
+    ASSERT_EQ(CardSet::fromCards(fromList), CardSet::fromCards(fromVector));
+    ASSERT_EQ(AdvancedHandEvaluator::evaluate(hand).score, AdvancedHandEvaluator::evaluate(cards).score);
+    ASSERT_EQ(fromList.from(2).size(), 5u);
+    ASSERT_TRUE(fromList.from(2)[0] == cards[2]);
+    ASSERT_TRUE(fromList.from(9).empty());
+
+    HoleCards hole = {cards[0], cards[1], cards[2], cards[3]};
+    bool threw = false;
+    try {
+        hole.push_back(cards[4]);
+    } catch (const std::length_error &) {
+        threw = true;
+    }
+    ASSERT_TRUE(threw);
+    ASSERT_EQ(hole.size(), HoleCards::capacity());
+    hole.clear();
+    ASSERT_TRUE(hole.empty());
+}
+
+// Test: Colex ranks are dense, unrank inverts rank, ranges split cleanly
+TEST(colex_rank_unrank) {
+    static_assert(choose(52, 2) == 1326 && choose(52, 3) == 22100 && choose(52, 7) == 133784560,
+                  "binomial table");
+    static_assert(choose(53, 2) == 0 && choose(-1, 2) == 0 && choose(52, 8) == 0, "outside the table");
+
+    CardSet deck = CardSet::fullDeck();
+    for (int k = 1; k <= 3; ++k) {
+        uint64_t expected = 0;
+        for (CardSet subset : SubsetRange(deck, k)) {
+            ASSERT_EQ(subset.size(), k);
+            ASSERT_EQ(Colex::rank(subset), expected);
+            ASSERT_EQ(Colex::unrank(expected, k), subset);
+            expected++;
+        }
+        ASSERT_EQ(expected, choose(52, k));
+    }
+
+    std::mt19937 rng(17);
+    for (int i = 0; i < 2000; ++i) {
+        std::vector<Card> hand = randomHand(rng, 7);
+        CardSet set = CardSet::fromCards(hand);
+        uint64_t r = Colex::rank(set);
+        ASSERT_TRUE(r < choose(52, 7));
+        ASSERT_EQ(Colex::unrank(r, 7), set);
+    }
+
+    // Subsets avoiding dead cards get dense ranks among the live cards
+    CardSet dead = CardSet::fromCards(randomHand(rng, 9));
+    CardSet live = deck.without(dead);
+    SubsetRange pairs(live, 2);
+    ASSERT_EQ(pairs.size(), choose(43, 2));
+
+    uint64_t expected = 0;
+    CardSet seen;
+    std::vector<SubsetRange> parts = pairs.split(7);
+    for (const SubsetRange &part : parts) {
+        for (CardSet pair : part) {
+            ASSERT_TRUE(!pair.intersects(dead));
+            ASSERT_EQ(Colex::rank(pair, live), expected);
+            ASSERT_EQ(Colex::unrank(expected, 2, live), pair);
+            seen |= pair;
+            expected++;
+        }
+    }
+    ASSERT_EQ(expected, pairs.size());
+    ASSERT_EQ(seen, live);
+
+    // Ranks past the last subset are refused, not walked below card 0
+    auto refuses = [](auto unrank) {
+        try {
+            unrank();
+        } catch (const std::out_of_range &) {
+            return true;
+        }
+        return false;
+    };
+    ASSERT_TRUE(refuses([] { return Colex::unrank(choose(52, 2), 2); }));
+    ASSERT_TRUE(refuses([] { return Colex::unrank(choose(52, 7), 7); }));
+    ASSERT_TRUE(refuses([] { return Colex::unrank(0, 8); }));
+    ASSERT_TRUE(refuses([&] { return Colex::unrank(choose(43, 2), 2, live); }));
+    ASSERT_TRUE(!refuses([&] { return Colex::unrank(choose(43, 2) - 1, 2, live); }));
+}
+
+// Relabel the suits of a set: suit s becomes permutation[s]
+static CardSet permuteSuits(CardSet set, const std::array<int, 4> &permutation) {
+    CardSet out;
+    for (int s = 0; s < 4; ++s)
+        out.bits |= uint64_t(set.suitMask(s)) << (16 * permutation[s]);
+    return out;
+}
+
+// Test: Suit-isomorphic indices are dense, suit-blind and invertible
+TEST(hand_indexer_isomorphism) {
+    ASSERT_EQ(HandIndexer({2}).size(), 169u);
+    ASSERT_EQ(HandIndexer({3}).size(), 1755u);
+    ASSERT_EQ(HandIndexer::forBoard(3).size(), 1286792u);
+    ASSERT_EQ(HandIndexer::forBoard(4).size(), 13960050u);
+    ASSERT_EQ(HandIndexer::forBoard(5).size(), 123156254u);
+
+    // Every preflop index is reached, and only by isomorphic hands
+    const HandIndexer &preflop = HandIndexer::forBoard(0);
+    std::vector<int> hits(preflop.size(), 0);
+    for (CardSet hole : SubsetRange(CardSet::fullDeck(), 2)) {
+        uint64_t i = preflop.index(&hole);
+        ASSERT_TRUE(i < preflop.size());
+        hits[i]++;
+    }
+    // 13 pairs in 6 suit labellings, 78 suited hands in 4, 78 offsuit in 12
+    int classes[13] = {};
+    for (uint64_t i = 0; i < preflop.size(); ++i) {
+        CardSet hole;
+        preflop.unindex(i, &hole);
+        ASSERT_EQ(preflop.index(&hole), i);
+        classes[hits[i]]++;
+    }
+    ASSERT_EQ(classes[6], 13);
+    ASSERT_EQ(classes[4], 78);
+    ASSERT_EQ(classes[12], 78);
+
+    std::mt19937 rng(18);
+    std::array<int, 4> permutation = {0, 1, 2, 3};
+    for (int n = 0; n < 3000; ++n) {
+        size_t boardSize = 3 + n % 3;
+        std::vector<Card> cards = randomHand(rng, 2 + boardSize);
+        std::vector<Card> hole(cards.begin(), cards.begin() + 2);
+        std::vector<Card> board(cards.begin() + 2, cards.end());
+        const HandIndexer &indexer = HandIndexer::forBoard(static_cast<int>(boardSize));
+        CardSet rounds[2] = {CardSet::fromCards(hole), CardSet::fromCards(board)};
+        uint64_t i = HandIndexer::indexOf(hole, board);
+        ASSERT_TRUE(i < indexer.size());
+
+        std::shuffle(permutation.begin(), permutation.end(), rng);
+        CardSet permuted[2] = {permuteSuits(rounds[0], permutation), permuteSuits(rounds[1], permutation)};
+        ASSERT_EQ(indexer.index(permuted), i);
+
+        // The canonical form is the same hand under some suit relabelling
+        CardSet canonical[2];
+        indexer.canonicalize(rounds, canonical);
+        ASSERT_EQ(indexer.index(canonical), i);
+        ASSERT_EQ(BitmaskHandEvaluator::evaluate(canonical[0] | canonical[1]),
+                  BitmaskHandEvaluator::evaluate(rounds[0] | rounds[1]));
+        bool relabelled = false;
+        std::array<int, 4> p = {0, 1, 2, 3};
+        do {
+            relabelled = relabelled || (permuteSuits(rounds[0], p) == canonical[0] &&
+                                        permuteSuits(rounds[1], p) == canonical[1]);
+        } while (std::next_permutation(p.begin(), p.end()));
+        ASSERT_TRUE(relabelled);
+
+        // And arbitrary indices round-trip
+        uint64_t j = std::uniform_int_distribution<uint64_t>(0, indexer.size() - 1)(rng);
+        indexer.unindex(j, canonical);
+        ASSERT_EQ(canonical[0].size(), 2);
+        ASSERT_EQ(canonical[1].size(), static_cast<int>(boardSize));
+        ASSERT_TRUE(!canonical[0].intersects(canonical[1]));
+        ASSERT_EQ(indexer.index(canonical), j);
+    }
+}
+
+// Test: Scoring hole pairs against a shared board matches full evaluation
+TEST(shared_board_matches_bitmask) {
+    std::mt19937 rng(1212);
+    for (int i = 0; i < 2000; ++i) {
+        size_t boardSize = 3 + i % 3;
+        std::vector<Card> cards = randomHand(rng, boardSize + 2 * 8);
+        std::vector<Card> board(cards.begin(), cards.begin() + boardSize);
+
+        std::vector<HolePair> holes;
+        for (size_t k = boardSize; k < cards.size(); k += 2)
+            holes.push_back({toCardId(cards[k]), toCardId(cards[k + 1])});
+
+        std::vector<uint32_t> scores(holes.size());
+        AdvancedHandEvaluator::evaluateAgainstBoard(board, holes.data(), scores.data(), holes.size());
+        for (size_t h = 0; h < holes.size(); ++h) {
+            std::vector<Card> hand = board;
+            hand.push_back(cards[boardSize + 2 * h]);
+            hand.push_back(cards[boardSize + 2 * h + 1]);
+            ASSERT_EQ(scores[h], BitmaskHandEvaluator::evaluate(CardSet::fromCards(hand)));
+        }
+    }
+}
+
+// Best 8-or-better low of any 5-card subset as low values 1-8, highest
+// first; empty when no subset qualifies
+static std::vector<int> bruteForceLow(const std::vector<Card> &cards) {
+    std::vector<int> best;
+    for (CardSet five : SubsetRange(CardSet::fromCards(cards), 5)) {
+        std::vector<int> low;
+        for (const Card &c : five.toCards()) {
+            int r = static_cast<int>(c.rank);
+            low.push_back(r == 14 ? 1 : r);
+        }
+        std::sort(low.rbegin(), low.rend());
+        if (low[0] > 8 || std::adjacent_find(low.begin(), low.end()) != low.end())
+            continue;
+        // Lexicographically smaller, highest card first, is the better low
+        if (best.empty() || low < best)
+            best = low;
+    }
+    return best;
+}
+
+// Test: Low evaluator matches the best of every 5-card subset, and better
+// lows score higher
+TEST(low_matches_brute_force) {
+    std::mt19937 rng(88);
+    for (int i = 0; i < 5000; ++i) {
+        std::vector<Card> cards = randomHand(rng, 5 + i % 3);
+        std::vector<int> expected = bruteForceLow(cards);
+        uint32_t low = LowHandEvaluator::evaluate(CardSet::fromCards(cards));
+        ASSERT_EQ(LowHandEvaluator::lowCards(low), expected);
+        ASSERT_EQ(low == LowHandEvaluator::NO_LOW, expected.empty());
+
+        HiLoScore hiLo = LowHandEvaluator::evaluateHiLo(cards);
+        ASSERT_EQ(hiLo.high, BitmaskHandEvaluator::evaluate(CardSet::fromCards(cards)));
+        ASSERT_EQ(hiLo.low, low);
+
+        std::vector<Card> other = randomHand(rng, 7);
+        std::vector<int> otherLow = bruteForceLow(other);
+        uint32_t otherScore = LowHandEvaluator::evaluate(CardSet::fromCards(other));
+        if (!expected.empty() && !otherLow.empty())
+            ASSERT_EQ(low > otherScore, expected < otherLow);
+    }
+}
+
+// Test: The wheel is the best low, a Nine never qualifies, pairs are skipped
+TEST(low_rules) {
+    std::vector<Card> wheel = {
+        Card(Rank::Ace, Suit::Hearts), Card(Rank::Two, Suit::Clubs), Card(Rank::Three, Suit::Spades),
+        Card(Rank::Four, Suit::Diamonds), Card(Rank::Five, Suit::Hearts)
+    };
+    HiLoScore hiLo = LowHandEvaluator::evaluateHiLo(wheel);
+    ASSERT_EQ(HandValue::fromScore(hiLo.high).rank, HandRank::Straight);
+    ASSERT_EQ(hiLo.low, LowHandEvaluator::evaluateMask(0x1F));
+    for (int mask = 0; mask < 256; ++mask)
+        ASSERT_TRUE(LowHandEvaluator::evaluateMask(static_cast<uint8_t>(mask)) <= hiLo.low);
+
+    std::vector<Card> nineHigh = {
+        Card(Rank::Nine, Suit::Hearts), Card(Rank::Two, Suit::Clubs), Card(Rank::Three, Suit::Spades),
+        Card(Rank::Four, Suit::Diamonds), Card(Rank::Five, Suit::Hearts), Card(Rank::Five, Suit::Clubs),
+        Card(Rank::King, Suit::Clubs)
+    };
+    ASSERT_EQ(LowHandEvaluator::evaluate(CardSet::fromCards(nineHigh)), LowHandEvaluator::NO_LOW);
+
+    nineHigh[0] = Card(Rank::Eight, Suit::Hearts);
+    ASSERT_EQ(LowHandEvaluator::lowCards(LowHandEvaluator::evaluate(CardSet::fromCards(nineHigh))),
+              (std::vector<int>{8, 5, 4, 3, 2}));
+}
+
+// Test: Omaha Hi/Lo finds the best high and the best low, each made from
+// exactly two hole and three board cards
+TEST(omaha_hi_lo_matches_brute_force) {
+    std::mt19937 rng(808);
+    for (int i = 0; i < 3000; ++i) {
+        size_t boardSize = 3 + i % 3;
+        std::vector<Card> cards = randomHand(rng, 4 + boardSize);
+        std::vector<Card> hole(cards.begin(), cards.begin() + 4);
+        std::vector<Card> board(cards.begin() + 4, cards.end());
+
+        uint32_t bestHigh = 0;
+        uint32_t bestLow = LowHandEvaluator::NO_LOW;
+        for (CardSet two : SubsetRange(CardSet::fromCards(hole), 2))
+            for (CardSet three : SubsetRange(CardSet::fromCards(board), 3)) {
+                CardSet five = two | three;
+                bestHigh = std::max(bestHigh, AdvancedHandEvaluator::evaluate(five.toCards()).score);
+                bestLow = std::max(bestLow, LowHandEvaluator::evaluate(five));
+            }
+
+        HiLoScore hiLo = OmahaHandEvaluator::evaluateHiLo(hole, board);
+        ASSERT_EQ(hiLo.high, bestHigh);
+        ASSERT_EQ(hiLo.low, bestLow);
+    }
+}
+
+// Short-deck score of one 5-card hand, built from the Hold'em evaluator
+static uint32_t shortDeckReference(const std::vector<Card> &five) {
+    static const uint32_t ORDER[10] = {0, 1, 2, 3, 4, 6, 5, 7, 8, 9};
+    CardSet set = CardSet::fromCards(five);
+    uint32_t score = BitmaskHandEvaluator::evaluate(set);
+    HandRank rank = HandValue::fromScore(score).rank;
+
+    // A-6-7-8-9 is a straight, topped by the Nine
+    uint32_t ranks = set.suitMask(0) | set.suitMask(1) | set.suitMask(2) | set.suitMask(3);
+    if (ranks == ((1u << 12) | (0xFu << 4))) {
+        rank = rank == HandRank::Flush ? HandRank::StraightFlush : HandRank::Straight;
+        score = 9u << 16;
+    }
+    uint32_t category = static_cast<uint32_t>(rank);
+    return (ORDER[category] << HandValue::ORDER_SHIFT) | (category << HandValue::CATEGORY_SHIFT) |
+           (score & 0xFFFFF);
+}
+
+static std::vector<Card> randomShortDeckHand(std::mt19937 &rng, size_t size) {
+    std::vector<Card> deck;
+    for (int s = 0; s < 4; ++s)
+        for (int r = ShortDeckEvaluator::LOWEST_RANK; r <= 14; ++r)
+            deck.emplace_back(static_cast<Rank>(r), static_cast<Suit>(s));
+    std::shuffle(deck.begin(), deck.end(), rng);
+    deck.erase(deck.begin() + size, deck.end());
+    return deck;
+}
+
+// Test: Short-deck evaluator matches the best of every 5-card subset
+TEST(short_deck_matches_reference) {
+    std::mt19937 rng(6);
+    for (int i = 0; i < 20000; ++i) {
+        size_t size = 5 + i % 3;
+        std::vector<Card> hand = randomShortDeckHand(rng, size);
+
+        uint32_t expected = 0;
+        for (uint32_t pick = 0; pick < (1u << size); ++pick) {
+            if (__builtin_popcount(pick) != 5)
+                continue;
+            std::vector<Card> five;
+            for (size_t c = 0; c < size; ++c)
+                if (pick & (1u << c))
+                    five.push_back(hand[c]);
+            expected = std::max(expected, shortDeckReference(five));
+        }
+        ASSERT_EQ(ShortDeckEvaluator::evaluate(hand).score, expected);
+    }
+}
+
+// Test: Short-deck rules: flush beats full house, A-6-7-8-9 is a straight
+TEST(short_deck_rules) {
+    std::vector<Card> flush = {
+        Card(Rank::Ace, Suit::Hearts), Card(Rank::Jack, Suit::Hearts), Card(Rank::Nine, Suit::Hearts),
+        Card(Rank::Eight, Suit::Hearts), Card(Rank::Six, Suit::Hearts), Card(Rank::Six, Suit::Clubs),
+        Card(Rank::Six, Suit::Spades)
+    };
+    std::vector<Card> fullHouse = {
+        Card(Rank::Ace, Suit::Hearts), Card(Rank::Ace, Suit::Clubs), Card(Rank::Ace, Suit::Spades),
+        Card(Rank::King, Suit::Hearts), Card(Rank::King, Suit::Clubs), Card(Rank::Seven, Suit::Diamonds),
+        Card(Rank::Six, Suit::Spades)
+    };
+    std::vector<Card> wheel = {
+        Card(Rank::Ace, Suit::Hearts), Card(Rank::Six, Suit::Clubs), Card(Rank::Seven, Suit::Spades),
+        Card(Rank::Eight, Suit::Diamonds), Card(Rank::Nine, Suit::Hearts)
+    };
+
+    HandValue flushValue = ShortDeckEvaluator::evaluate(flush);
+    HandValue fullHouseValue = ShortDeckEvaluator::evaluate(fullHouse);
+    HandValue wheelValue = ShortDeckEvaluator::evaluate(wheel);
+    ASSERT_EQ(flushValue.rank, HandRank::Flush);
+    ASSERT_EQ(fullHouseValue.rank, HandRank::FullHouse);
+    ASSERT_TRUE(flushValue > fullHouseValue);
+    ASSERT_EQ(wheelValue.rank, HandRank::Straight);
+    ASSERT_EQ(wheelValue.kicker(0), 9);
+}
+
+// Test: Table files with the wrong version are refused
+TEST(lookup_table_rejects_stale_file) {
+    const char *path = "/tmp/poker_stale_hand_table.dat";
+    LookupTableEvaluator::FileHeader header = {};
+    std::copy(std::begin(LookupTableEvaluator::MAGIC), std::end(LookupTableEvaluator::MAGIC), header.magic);
+    header.version = LookupTableEvaluator::TABLE_VERSION + 1;
+    header.entryCount = 0;
+    FILE *f = std::fopen(path, "wb");
+    ASSERT_TRUE(f != nullptr);
+    std::fwrite(&header, sizeof(header), 1, f);
+    std::fclose(f);
+
+    bool wasLoaded = LookupTableEvaluator::isLoaded();
+    ASSERT_TRUE(!LookupTableEvaluator::load(path));
+    ASSERT_TRUE(!LookupTableEvaluator::load("/tmp/poker_missing_hand_table.dat"));
+    ASSERT_EQ(LookupTableEvaluator::isLoaded(), wasLoaded);
+    std::remove(path);
+
+    // Hands the table cannot score are refused before it is read
+    std::mt19937 rng(8);
+    bool threw = false;
+    try {
+        LookupTableEvaluator::evaluate(randomHand(rng, 8));
+    } catch (const std::invalid_argument &) {
+        threw = true;
+    }
+    ASSERT_TRUE(threw);
+}
+
+// Test: Lookup table agrees with the bitmask evaluator (needs `make hand_table`)
+TEST(lookup_table_matches_bitmask) {
+    if (AdvancedHandEvaluator::mode() != EvaluatorMode::LookupTable) {
+        std::cout << "(no hand table, skipped) ";
+        return;
+    }
+    std::mt19937 rng(2024);
+    for (size_t size = 5; size <= 7; ++size) {
+        for (int i = 0; i < 20000; ++i) {
+            std::vector<Card> hand = randomHand(rng, size);
+            ASSERT_EQ(LookupTableEvaluator::evaluate(hand),
+                      BitmaskHandEvaluator::evaluate(CardSet::fromCards(hand)));
+        }
+    }
+
+    // The table backend refuses what the table cannot score
+    const EvaluatorBackend *table = EvaluatorRegistry::find("table");
+    ASSERT_TRUE(table != nullptr);
+    for (size_t size : {4, 8}) {
+        bool threw = false;
+        try {
+            table->evaluate(CardSet::fromCards(randomHand(rng, size)));
+        } catch (const std::invalid_argument &) {
+            threw = true;
+        }
+        ASSERT_TRUE(threw);
+    }
+}
+
 int main() {
     std::cout << "=== Hand Evaluator Unit Tests ===\n\n";
     
@@ -222,6 +948,30 @@ int main() {
     RUN_TEST(one_pair_detection);
     RUN_TEST(royal_flush_beats_straight_flush);
     RUN_TEST(kicker_comparison);
+    RUN_TEST(highest_straight_plays);
+    RUN_TEST(quads_kicker_from_pair);
+    RUN_TEST(bitmask_matches_reference);
+    RUN_TEST(packed_score_ordering);
+    RUN_TEST(packed_hand_value_view);
+    RUN_TEST(batch_kernels_match_scalar);
+    RUN_TEST(eval_state_matches_bitmask);
+    RUN_TEST(eval_state_branching);
+    RUN_TEST(fixed_size_matches_bitmask);
+    RUN_TEST(registry_backends_agree);
+    RUN_TEST(omaha_matches_brute_force);
+    RUN_TEST(omaha_exactly_two_hole_cards);
+    RUN_TEST(card_set_operations);
+    RUN_TEST(card_list_views);
+    RUN_TEST(colex_rank_unrank);
+    RUN_TEST(hand_indexer_isomorphism);
+    RUN_TEST(shared_board_matches_bitmask);
+    RUN_TEST(low_matches_brute_force);
+    RUN_TEST(low_rules);
+    RUN_TEST(omaha_hi_lo_matches_brute_force);
+    RUN_TEST(short_deck_matches_reference);
+    RUN_TEST(short_deck_rules);
+    RUN_TEST(lookup_table_rejects_stale_file);
+    RUN_TEST(lookup_table_matches_bitmask);
     
     std::cout << "\n✓ All tests passed!\n";
     return 0;
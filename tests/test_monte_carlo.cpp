@@ -6,10 +6,18 @@
  */
 
 #include "../montecarlo/MonteCarloSimulator.h"
+#include "../model/bitmask_hand_evaluator.h"
+#include "../model/deal_generator.h"
+#include "../model/deck.h"
+#include "../model/kronecker_deck.h"
+#include "../model/poker_math.h"
+#include "../model/rng.h"
 #include "../model/card.h"
+#include "../utils/work_stealing_pool.h"
 #include <iostream>
 #include <cassert>
 #include <cmath>
+#include <stdexcept>
 #include <vector>
 
 // Simple test framework
@@ -169,6 +177,689 @@ TEST(confidence_interval_scaling) {
     
     // 99% CI should be wider than 95% CI
     ASSERT_TRUE(width99 > width95);
+
+    // Any level gets its own z, not the nearest of 90/95/99%
+    auto [lower80, upper80] = sim.getConfidenceInterval(0.80);
+    ASSERT_NEAR(upper80 - lower80, 2 * 1.281552 * sim.getWinRateStdDev(), 1e-5);
+}
+
+// Test: Omaha mode deals four opponent cards and uses the Omaha rules
+TEST(omaha_simulation) {
+    std::vector<Card> playerHand = {
+        Card(Rank::Ace, Suit::Spades),
+        Card(Rank::King, Suit::Spades),
+        Card(Rank::Two, Suit::Clubs),
+        Card(Rank::Three, Suit::Diamonds)
+    };
+    std::vector<Card> community = {
+        Card(Rank::Queen, Suit::Spades),
+        Card(Rank::Jack, Suit::Spades),
+        Card(Rank::Ten, Suit::Spades)
+    };
+
+    MonteCarloSimulator sim(playerHand, community, 300, GameVariant::Omaha);
+    sim.runSimulation();
+
+    // Royal flush with exactly two hole cards: nobody can beat it
+    ASSERT_NEAR(sim.getWinPercentage() + sim.getTiePercentage(), 1.0, 1e-9);
+    ASSERT_TRUE(sim.getWinPercentage() > 0.99);
+
+    bool threw = false;
+    try {
+        MonteCarloSimulator bad({playerHand[0], playerHand[1]}, community, 10, GameVariant::Omaha);
+    } catch (const std::invalid_argument &) {
+        threw = true;
+    }
+    ASSERT_TRUE(threw);
+}
+
+// Test: Short-deck mode deals from the 36-card deck
+TEST(short_deck_simulation) {
+    std::vector<Card> playerHand = {
+        Card(Rank::Ace, Suit::Hearts),
+        Card(Rank::Ace, Suit::Diamonds)
+    };
+    std::vector<Card> community = {
+        Card(Rank::Ace, Suit::Clubs),
+        Card(Rank::Ace, Suit::Spades),
+        Card(Rank::King, Suit::Hearts)
+    };
+
+    MonteCarloSimulator sim(playerHand, community, 300, GameVariant::ShortDeck);
+    sim.runSimulation();
+    ASSERT_NEAR(sim.getWinPercentage() + sim.getTiePercentage() + sim.getLosePercentage(), 1.0, 1e-9);
+    ASSERT_TRUE(sim.getWinPercentage() > 0.95);
+
+    // Five of the 31 unseen short-deck cards are hearts
+    std::vector<Card> drawHand = {Card(Rank::Six, Suit::Hearts), Card(Rank::Seven, Suit::Hearts)};
+    std::vector<Card> drawBoard = {Card(Rank::Queen, Suit::Hearts), Card(Rank::King, Suit::Hearts),
+                                   Card(Rank::Nine, Suit::Clubs)};
+    MonteCarloSimulator drawSim(drawHand, drawBoard, 10, GameVariant::ShortDeck);
+    ASSERT_NEAR(drawSim.getFlushDrawOdds(), 5.0 / 31.0, 1e-9);
+
+    bool threw = false;
+    try {
+        MonteCarloSimulator bad({Card(Rank::Two, Suit::Hearts), Card(Rank::Ace, Suit::Spades)},
+                                community, 10, GameVariant::ShortDeck);
+    } catch (const std::invalid_argument &) {
+        threw = true;
+    }
+    ASSERT_TRUE(threw);
+}
+
+// Test: Hi/Lo simulation splits pots and reports scoops
+TEST(hi_lo_simulation) {
+    // The nut low with a made wheel: never lose the low, usually scoop
+    std::vector<Card> playerHand = {
+        Card(Rank::Ace, Suit::Hearts),
+        Card(Rank::Two, Suit::Diamonds)
+    };
+    std::vector<Card> community = {
+        Card(Rank::Three, Suit::Clubs),
+        Card(Rank::Four, Suit::Spades),
+        Card(Rank::Five, Suit::Hearts)
+    };
+
+    MonteCarloSimulator sim(playerHand, community, 400, GameVariant::HoldemHiLo);
+    sim.runSimulation();
+    ASSERT_NEAR(sim.getWinPercentage() + sim.getTiePercentage() + sim.getLosePercentage(), 1.0, 1e-9);
+    ASSERT_TRUE(sim.getScoopPercentage() + sim.getHighOnlyPercentage() + sim.getLowOnlyPercentage() <= 1.0);
+    ASSERT_TRUE(sim.getScoopPercentage() > 0.5);
+    ASSERT_TRUE(sim.getLosePercentage() < 0.1);
+
+    std::vector<Card> omahaHand = {
+        Card(Rank::Ace, Suit::Hearts),
+        Card(Rank::Two, Suit::Hearts),
+        Card(Rank::King, Suit::Hearts),
+        Card(Rank::King, Suit::Spades)
+    };
+    MonteCarloSimulator omahaSim(omahaHand, community, 300, GameVariant::OmahaHiLo);
+    omahaSim.runSimulation();
+    ASSERT_NEAR(omahaSim.getWinPercentage() + omahaSim.getTiePercentage() + omahaSim.getLosePercentage(),
+                1.0, 1e-9);
+    ASSERT_TRUE(omahaSim.getScoopPercentage() + omahaSim.getLowOnlyPercentage() > 0.5);
+
+    bool threw = false;
+    try {
+        MonteCarloSimulator bad(playerHand, community, 10, GameVariant::OmahaHiLo);
+    } catch (const std::invalid_argument &) {
+        threw = true;
+    }
+    ASSERT_TRUE(threw);
+}
+
+// Test: Deck deals every live card once, skips dead cards and resets
+TEST(deck_partial_shuffle) {
+    CardSet dead;
+    dead.add(Card(Rank::Ace, Suit::Spades));
+    dead.add(Card(Rank::King, Suit::Hearts));
+
+    Deck deck(GameVariant::Holdem, dead);
+    deck.seed(7);
+    ASSERT_TRUE(deck.size() == 50);
+
+    for (int round = 0; round < 3; ++round) {
+        deck.reset();
+        CardSet dealt;
+        while (!deck.isEmpty()) {
+            CardId id = deck.dealId();
+            ASSERT_TRUE(!dealt.contains(id));
+            dealt.add(id);
+        }
+        ASSERT_TRUE(dealt == CardSet::fullDeck().without(dead));
+    }
+
+    // The same seed deals the same cards
+    Deck again(GameVariant::Holdem, dead);
+    Deck fromStream(GameVariant::Holdem, dead);
+    Deck builtFromStream(GameVariant::Holdem, dead, Rng(99));
+    deck.seed(99);
+    again.seed(99);
+    fromStream.seed(Rng(99));
+    CardSet first = deck.deal(7);
+    ASSERT_TRUE(first == again.deal(7));
+    ASSERT_TRUE(first == fromStream.deal(7));
+    ASSERT_TRUE(first == builtFromStream.deal(7));
+
+    // Each card is equally likely to come first
+    Deck shortDeck(GameVariant::ShortDeck);
+    shortDeck.seed(3);
+    int firstCounts[52] = {};
+    const int trials = 36000;
+    for (int t = 0; t < trials; ++t) {
+        shortDeck.reset();
+        firstCounts[shortDeck.dealId()]++;
+    }
+    for (CardId id : CardSet::fullDeck(6))
+        ASSERT_NEAR(firstCounts[id], trials / 36.0, 150.0);
+    ASSERT_TRUE(firstCounts[toCardId(Card(Rank::Two, Suit::Clubs))] == 0);
+}
+
+// Test: Rng streams are reproducible from one seed and do not coincide
+TEST(rng_streams) {
+    Rng a(42), b(42);
+    for (int i = 0; i < 1000; ++i)
+        ASSERT_TRUE(a() == b());
+
+    // stream(seed, i) is the seed's generator split i times
+    Rng master(42);
+    Rng first = master.split();
+    Rng second = master.split();
+    Rng expectFirst = Rng::stream(42, 0);
+    Rng expectSecond = Rng::stream(42, 1);
+    bool differ = false;
+    for (int i = 0; i < 100; ++i) {
+        uint64_t x = first(), y = second();
+        ASSERT_TRUE(x == expectFirst());
+        ASSERT_TRUE(y == expectSecond());
+        differ = differ || x != y;
+    }
+    ASSERT_TRUE(differ);
+
+    // below(n) stays in range and is close to uniform
+    Rng rng(5);
+    int counts[7] = {};
+    const int draws = 70000;
+    for (int i = 0; i < draws; ++i) {
+        uint32_t v = rng.below(7);
+        ASSERT_TRUE(v < 7);
+        counts[v]++;
+    }
+    for (int c : counts)
+        ASSERT_NEAR(c, draws / 7.0, 400.0);
+
+    double u = rng.uniform();
+    ASSERT_TRUE(u >= 0.0 && u < 1.0);
+}
+
+// Test: Deal generator deals distinct cards for its variant and replays from its seed
+TEST(deal_generator_replays) {
+    DealGenerator first(6, 2024, GameVariant::Holdem, 100);
+    DealGenerator second(6, 2024, GameVariant::Holdem, 100);
+    DealGenerator other(6, 2025, GameVariant::Holdem, 100);
+
+    int sameAsOther = 0;
+    int firstCounts[52] = {};
+    const int deals = 5200; // spans many blocks and ring wrap-arounds
+    for (int d = 0; d < deals; ++d) {
+        DealGenerator::Deal a = first.next();
+        DealGenerator::Deal b = second.next();
+        DealGenerator::Deal c = other.next();
+
+        CardSet seen;
+        for (int i = 0; i < 2 * 6 + 5; ++i) {
+            ASSERT_TRUE(a.cards[i] < 52);
+            ASSERT_TRUE(!seen.contains(a.cards[i]));
+            seen.add(a.cards[i]);
+            ASSERT_TRUE(a.cards[i] == b.cards[i]);
+        }
+        sameAsOther += a.cards[0] == c.cards[0];
+        firstCounts[a.hole(0)[0]]++;
+        ASSERT_TRUE(a.board(4) == a.cards[16]);
+    }
+    ASSERT_TRUE(sameAsOther < deals / 10);
+    for (int count : firstCounts)
+        ASSERT_NEAR(count, deals / 52.0, 45.0);
+
+    // Short deck deals stay within the 36-card deck
+    DealGenerator shortDeals(2, 1, GameVariant::ShortDeck, 16);
+    for (int i = 0; i < 100; ++i) {
+        DealGenerator::Block block = shortDeals.nextBlock();
+        for (int d = 0; d < block.count; ++d)
+            for (CardId id : block.deal(d).hole(1))
+                ASSERT_TRUE(CardSet::fullDeck(6).contains(id));
+    }
+
+    // Omaha deals four hole cards a seat ahead of the board
+    DealGenerator omaha(3, 7, GameVariant::Omaha, 16);
+    ASSERT_TRUE(omaha.holeCards() == 4);
+    for (int d = 0; d < 100; ++d) {
+        DealGenerator::Deal deal = omaha.next();
+        CardSet seen;
+        for (int seat = 0; seat < 3; ++seat) {
+            ASSERT_TRUE(deal.hole(seat).size() == 4);
+            for (CardId id : deal.hole(seat))
+                seen.add(id);
+        }
+        ASSERT_TRUE(seen.size() == 12);
+        ASSERT_TRUE(deal.hole(2)[3] == deal.cards[11]);
+        ASSERT_TRUE(deal.board(0) == deal.cards[12]);
+        for (int i = 0; i < 5; ++i)
+            seen.add(deal.board(i));
+        ASSERT_TRUE(seen.size() == 17);
+    }
+
+    bool threw = false;
+    try {
+        DealGenerator tooMany(24, 1);
+    } catch (const std::invalid_argument &) {
+        threw = true;
+    }
+    ASSERT_TRUE(threw);
+
+    // Twelve Omaha seats and the board need 53 cards
+    threw = false;
+    try {
+        DealGenerator tooManyOmaha(12, 1, GameVariant::Omaha);
+    } catch (const std::invalid_argument &) {
+        threw = true;
+    }
+    ASSERT_TRUE(threw);
+}
+
+// Test: Pool runs every index once, with per-worker slots never shared
+TEST(work_stealing_pool) {
+    WorkStealingPool pool(4);
+    ASSERT_TRUE(pool.size() == 4);
+
+    // Uneven work: the early indices are slow, so later workers must steal
+    std::vector<int> hits(1000, 0);
+    std::vector<long> perWorker(pool.size(), 0);
+    pool.run(hits.size(), [&](size_t i, unsigned worker) {
+        volatile long spin = 0;
+        for (size_t k = 0; k < (i < 100 ? 20000 : 10); ++k)
+            spin = spin + 1;
+        hits[i]++;
+        perWorker[worker] += static_cast<long>(i);
+    });
+    long sum = 0;
+    for (int h : hits)
+        ASSERT_TRUE(h == 1);
+    for (long w : perWorker)
+        sum += w;
+    ASSERT_TRUE(sum == 999L * 1000 / 2);
+
+    bool threw = false;
+    try {
+        pool.run(10, [](size_t i, unsigned) {
+            if (i == 7)
+                throw std::runtime_error("task failed");
+        });
+    } catch (const std::runtime_error &) {
+        threw = true;
+    }
+    ASSERT_TRUE(threw);
+}
+
+// Test: A seed gives the same counts on any number of threads
+TEST(parallel_simulation_is_deterministic) {
+    std::vector<Card> playerHand = {Card(Rank::Queen, Suit::Spades), Card(Rank::Jack, Suit::Spades)};
+    std::vector<Card> community = {Card(Rank::Ten, Suit::Spades), Card(Rank::Two, Suit::Hearts),
+                                   Card(Rank::Nine, Suit::Clubs)};
+
+    for (GameVariant variant : {GameVariant::Holdem, GameVariant::OmahaHiLo}) {
+        std::vector<Card> hand = playerHand;
+        if (isOmaha(variant)) {
+            hand.push_back(Card(Rank::Ace, Suit::Diamonds));
+            hand.push_back(Card(Rank::Three, Suit::Diamonds));
+        }
+
+        std::vector<double> wins, ties, scoops;
+        for (unsigned threads : {1u, 2u, 3u, 0u}) {
+            MonteCarloSimulator sim(hand, community, 20000, variant);
+            sim.setSeed(4242);
+            sim.setThreadCount(threads);
+            sim.runSimulation();
+            wins.push_back(sim.getWinPercentage());
+            ties.push_back(sim.getTiePercentage());
+            scoops.push_back(sim.getScoopPercentage());
+        }
+        for (size_t i = 1; i < wins.size(); ++i) {
+            ASSERT_TRUE(wins[i] == wins[0]);
+            ASSERT_TRUE(ties[i] == ties[0]);
+            ASSERT_TRUE(scoops[i] == scoops[0]);
+        }
+
+        MonteCarloSimulator other(hand, community, 20000, variant);
+        other.setSeed(4243);
+        other.runSimulation();
+        ASSERT_TRUE(other.getWinPercentage() != wins[0]);
+        ASSERT_NEAR(other.getWinPercentage(), wins[0], 0.03);
+    }
+}
+
+// Test: Several opponents split pots evenly and match full evaluation
+TEST(multiway_equity) {
+    // A royal flush on the board: every seat plays it and splits the pot
+    std::vector<Card> royal = {Card(Rank::Ten, Suit::Spades), Card(Rank::Jack, Suit::Spades),
+                               Card(Rank::Queen, Suit::Spades), Card(Rank::King, Suit::Spades),
+                               Card(Rank::Ace, Suit::Spades)};
+    std::vector<Card> weak = {Card(Rank::Two, Suit::Hearts), Card(Rank::Seven, Suit::Clubs)};
+    for (GameVariant variant : {GameVariant::Holdem, GameVariant::HoldemHiLo}) {
+        for (int opponents : {2, 5, 9}) {
+            MonteCarloSimulator sim(weak, royal, 500, variant, opponents);
+            sim.runSimulation();
+            ASSERT_NEAR(sim.getTiePercentage(), 1.0, 1e-12);
+            ASSERT_NEAR(sim.getEquity(), 1.0 / (opponents + 1), 1e-12);
+        }
+    }
+
+    // Against full evaluation of every seat with the same split accounting
+    std::vector<Card> hand = {Card(Rank::King, Suit::Hearts), Card(Rank::Queen, Suit::Hearts)};
+    std::vector<Card> flop = {Card(Rank::Jack, Suit::Hearts), Card(Rank::Four, Suit::Clubs),
+                              Card(Rank::King, Suit::Diamonds)};
+    const int opponents = 6;
+    const int trials = 20000;
+    MonteCarloSimulator sim(hand, flop, trials, GameVariant::Holdem, opponents);
+    sim.runSimulation();
+    ASSERT_NEAR(sim.getWinPercentage() + sim.getTiePercentage() + sim.getLosePercentage(), 1.0, 1e-9);
+    ASSERT_TRUE(sim.getEquity() >= sim.getWinPercentage());
+    ASSERT_TRUE(sim.getEquity() <= sim.getWinPercentage() + sim.getTiePercentage());
+
+    // Scoops are Hi/Lo outcomes, whatever the opponent count
+    ASSERT_TRUE(sim.getWinPercentage() > 0.0);
+    ASSERT_NEAR(sim.getScoopPercentage(), 0.0, 1e-12);
+    ASSERT_NEAR(sim.getHighOnlyPercentage(), 0.0, 1e-12);
+    ASSERT_NEAR(sim.getLowOnlyPercentage(), 0.0, 1e-12);
+
+    Deck deck(GameVariant::Holdem, CardSet::fromCards(hand) | CardSet::fromCards(flop));
+    deck.seed(31);
+    double equity = 0.0;
+    for (int t = 0; t < trials; ++t) {
+        deck.reset();
+        CardSet board = CardSet::fromCards(flop) | deck.deal(2);
+        uint32_t player = BitmaskHandEvaluator::evaluate(board | CardSet::fromCards(hand));
+        uint32_t best = player;
+        int tied = 1;
+        for (int o = 0; o < opponents; ++o) {
+            uint32_t score = BitmaskHandEvaluator::evaluate(board | deck.deal(2));
+            if (score > best) {
+                best = score;
+                tied = 0;
+            }
+            tied += score == best && score == player;
+        }
+        if (best == player)
+            equity += 1.0 / tied;
+    }
+    ASSERT_NEAR(sim.getEquity(), equity / trials, 0.02);
+
+    // More opponents leave a smaller share
+    MonteCarloSimulator headsUp(hand, flop, trials, GameVariant::Holdem, 1);
+    headsUp.runSimulation();
+    ASSERT_TRUE(headsUp.getEquity() > sim.getEquity() + 0.1);
+
+    MonteCarloSimulator omaha({Card(Rank::Ace, Suit::Hearts), Card(Rank::Two, Suit::Hearts),
+                               Card(Rank::Three, Suit::Clubs), Card(Rank::King, Suit::Spades)},
+                              flop, 2000, GameVariant::OmahaHiLo, 4);
+    omaha.runSimulation();
+    ASSERT_TRUE(omaha.getEquity() > 0.0 && omaha.getEquity() < 1.0);
+
+    bool threw = false;
+    try {
+        MonteCarloSimulator tooMany(hand, flop, 10, GameVariant::Holdem, 10);
+    } catch (const std::invalid_argument &) {
+        threw = true;
+    }
+    ASSERT_TRUE(threw);
+}
+
+// Test: Exact enumeration counts every runout once and matches brute force
+TEST(exact_enumeration) {
+    std::vector<Card> hand = {Card(Rank::Ace, Suit::Clubs), Card(Rank::Ten, Suit::Clubs)};
+    std::vector<Card> river = {Card(Rank::Ten, Suit::Hearts), Card(Rank::Six, Suit::Clubs),
+                               Card(Rank::Two, Suit::Clubs), Card(Rank::King, Suit::Spades),
+                               Card(Rank::Four, Suit::Diamonds)};
+    std::vector<Card> turn(river.begin(), river.end() - 1);
+    std::vector<Card> flop(river.begin(), river.end() - 2);
+
+    ASSERT_TRUE(MonteCarloSimulator(hand, river).exactCombinations() == 990);
+    ASSERT_TRUE(MonteCarloSimulator(hand, turn).exactCombinations() == 46 * 990);
+    ASSERT_TRUE(MonteCarloSimulator(hand, flop).exactCombinations() == 1081 * 990);
+
+    // River: every opponent holding, scored directly
+    CardSet board = CardSet::fromCards(river);
+    CardSet live = CardSet::fullDeck().without(board | CardSet::fromCards(hand));
+    uint32_t player = BitmaskHandEvaluator::evaluate(board | CardSet::fromCards(hand));
+    int wins = 0, ties = 0, total = 0;
+    for (CardId a : live) {
+        for (CardId b : live) {
+            if (b <= a)
+                continue;
+            uint32_t opponent = BitmaskHandEvaluator::evaluate(board | CardSet::of(a) | CardSet::of(b));
+            wins += player > opponent;
+            ties += player == opponent;
+            total++;
+        }
+    }
+
+    MonteCarloSimulator sim(hand, river, 1000);
+    sim.runSimulation();
+    ASSERT_TRUE(sim.isExact());
+    ASSERT_TRUE(sim.getSampleSize() == total);
+    ASSERT_NEAR(sim.getWinPercentage(), static_cast<double>(wins) / total, 1e-12);
+    ASSERT_NEAR(sim.getTiePercentage(), static_cast<double>(ties) / total, 1e-12);
+    ASSERT_NEAR(sim.getWinRateStdDev(), 0.0, 0.0);
+
+    // Turn: exact agrees with a large sample, and on any thread count
+    MonteCarloSimulator exact(hand, turn, 50000);
+    exact.runSimulation();
+    ASSERT_TRUE(exact.isExact());
+    auto [lower, upper] = exact.getConfidenceInterval();
+    ASSERT_TRUE(lower == upper);
+
+    MonteCarloSimulator oneThread(hand, turn, 50000);
+    oneThread.setThreadCount(1);
+    oneThread.runSimulation();
+    ASSERT_TRUE(oneThread.getWinPercentage() == exact.getWinPercentage());
+    ASSERT_TRUE(oneThread.getEquity() == exact.getEquity());
+
+    MonteCarloSimulator sampled(hand, turn, 50000);
+    sampled.setMode(MonteCarloSimulator::Mode::Sample);
+    sampled.runSimulation();
+    ASSERT_TRUE(!sampled.isExact());
+    ASSERT_TRUE(sampled.getSampleSize() == 50000);
+    ASSERT_NEAR(sampled.getWinPercentage(), exact.getWinPercentage(), 4 * sampled.getWinRateStdDev());
+
+    // Too few simulations requested to cover the flop: Auto samples
+    MonteCarloSimulator flopSim(hand, flop, 5000);
+    flopSim.runSimulation();
+    ASSERT_TRUE(!flopSim.isExact());
+
+    // Hi/Lo and Omaha enumerate under their own rules
+    MonteCarloSimulator hiLo(hand, turn, 50000, GameVariant::HoldemHiLo);
+    hiLo.setMode(MonteCarloSimulator::Mode::Exact);
+    hiLo.runSimulation();
+    ASSERT_NEAR(hiLo.getWinPercentage() + hiLo.getTiePercentage() + hiLo.getLosePercentage(), 1.0, 1e-9);
+
+    std::vector<Card> omahaHand = {Card(Rank::Ace, Suit::Clubs), Card(Rank::Ten, Suit::Clubs),
+                                   Card(Rank::Three, Suit::Spades), Card(Rank::Five, Suit::Hearts)};
+    MonteCarloSimulator omaha(omahaHand, river, 200000, GameVariant::Omaha);
+    ASSERT_TRUE(omaha.exactCombinations() == 123410);
+    omaha.runSimulation();
+    ASSERT_TRUE(omaha.isExact());
+    ASSERT_TRUE(omaha.getSampleSize() == 123410);
+
+    bool threw = false;
+    try {
+        MonteCarloSimulator multiway(hand, river, 1000, GameVariant::Holdem, 3);
+        multiway.setMode(MonteCarloSimulator::Mode::Exact);
+        multiway.runSimulation();
+    } catch (const std::invalid_argument &) {
+        threw = true;
+    }
+    ASSERT_TRUE(threw);
+}
+
+// Test: A stopping rule ends clear spots early and close spots late, deterministically
+TEST(adaptive_stopping) {
+    ASSERT_NEAR(PokerMath::zScore(0.95), 1.959964, 1e-6);
+    ASSERT_NEAR(PokerMath::zScore(0.99), 2.575829, 1e-6);
+
+    // Aces against a random hand preflop: far above a 40% threshold
+    std::vector<Card> aces = {Card(Rank::Ace, Suit::Spades), Card(Rank::Ace, Suit::Hearts)};
+    MonteCarloSimulator clear(aces, {}, 200000);
+    clear.setSeed(7);
+    clear.setStoppingRule(0.005, 0.4);
+    clear.runSimulation();
+    ASSERT_TRUE(clear.getSampleSize() < 200000 / 10);
+    ASSERT_TRUE(clear.getConfidenceInterval().first > 0.4);
+
+    // The same spot without a threshold runs until the interval is tight
+    MonteCarloSimulator tight(aces, {}, 200000);
+    tight.setSeed(7);
+    tight.setStoppingRule(0.005);
+    tight.runSimulation();
+    ASSERT_TRUE(tight.getSampleSize() > clear.getSampleSize());
+    ASSERT_TRUE(tight.getSampleSize() < 200000);
+    ASSERT_TRUE(1.96 * tight.getWinRateStdDev() <= 0.005);
+
+    // A threshold sitting on the true win rate never clears: the budget runs out
+    MonteCarloSimulator close(aces, {}, 20000);
+    close.setSeed(7);
+    close.setStoppingRule(0.0001, tight.getWinPercentage());
+    close.runSimulation();
+    ASSERT_TRUE(close.getSampleSize() == 20000);
+
+    // Where it stops depends on the seed alone
+    MonteCarloSimulator again(aces, {}, 200000);
+    again.setSeed(7);
+    again.setThreadCount(1);
+    again.setStoppingRule(0.005);
+    again.runSimulation();
+    ASSERT_TRUE(again.getSampleSize() == tight.getSampleSize());
+    ASSERT_TRUE(again.getWinPercentage() == tight.getWinPercentage());
+
+    // A small first round lets an easy spot stop after that many trials
+    MonteCarloSimulator quick(aces, {}, 20000);
+    quick.setSeed(7);
+    quick.setStoppingRule(0.02, 0.4, 0.95, 128);
+    quick.runSimulation();
+    ASSERT_TRUE(quick.getSampleSize() == 128);
+    ASSERT_TRUE(quick.getConfidenceInterval().first > 0.4);
+
+    bool threw = false;
+    try {
+        tight.setStoppingRule(0.0);
+    } catch (const std::invalid_argument &) {
+        threw = true;
+    }
+    ASSERT_TRUE(threw);
+}
+
+// Test: Stratified sampling with a control variate stays unbiased and beats plain sampling
+TEST(variance_reduction) {
+    std::vector<Card> hand = {Card(Rank::Ace, Suit::Clubs), Card(Rank::Ten, Suit::Clubs)};
+    std::vector<Card> turn = {Card(Rank::Ten, Suit::Hearts), Card(Rank::Six, Suit::Clubs),
+                              Card(Rank::Two, Suit::Clubs), Card(Rank::King, Suit::Spades)};
+
+    MonteCarloSimulator exact(hand, turn, 1000);
+    exact.setMode(MonteCarloSimulator::Mode::Exact);
+    exact.runSimulation();
+
+    MonteCarloSimulator plain(hand, turn, 20000);
+    plain.setMode(MonteCarloSimulator::Mode::Sample);
+    plain.setSeed(11);
+    plain.runSimulation();
+    ASSERT_NEAR(plain.getEffectiveSampleSize(), 20000.0, 1e-9);
+
+    MonteCarloSimulator reduced(hand, turn, 20000);
+    reduced.setMode(MonteCarloSimulator::Mode::Sample);
+    reduced.setVarianceReduction(MonteCarloSimulator::VarianceReduction::all());
+    reduced.setSeed(11);
+    reduced.runSimulation();
+
+    ASSERT_TRUE(reduced.getSampleSize() == 20000);
+    ASSERT_TRUE(reduced.getEffectiveSampleSize() > 1.5 * reduced.getSampleSize());
+    ASSERT_TRUE(reduced.getWinRateStdDev() < plain.getWinRateStdDev());
+    ASSERT_NEAR(reduced.getWinPercentage(), exact.getWinPercentage(), 4 * reduced.getWinRateStdDev());
+    ASSERT_NEAR(reduced.getEquity(), exact.getEquity(), 0.02);
+    ASSERT_NEAR(reduced.getWinPercentage() + reduced.getTiePercentage() + reduced.getLosePercentage(), 1.0, 1e-12);
+
+    // Strata are dealt by trial number, so the thread count changes nothing
+    MonteCarloSimulator oneThread(hand, turn, 20000);
+    oneThread.setMode(MonteCarloSimulator::Mode::Sample);
+    oneThread.setVarianceReduction(MonteCarloSimulator::VarianceReduction::all());
+    oneThread.setSeed(11);
+    oneThread.setThreadCount(1);
+    oneThread.runSimulation();
+    ASSERT_TRUE(oneThread.getWinPercentage() == reduced.getWinPercentage());
+
+    // Omaha stratifies on one hole card and has no control on the flop
+    // within a budget this small; it must still agree with plain sampling
+    std::vector<Card> omahaHand = {Card(Rank::Ace, Suit::Clubs), Card(Rank::Ten, Suit::Clubs),
+                                   Card(Rank::Three, Suit::Spades), Card(Rank::Five, Suit::Hearts)};
+    std::vector<Card> flop(turn.begin(), turn.end() - 1);
+    MonteCarloSimulator omahaPlain(omahaHand, flop, 20000, GameVariant::Omaha);
+    omahaPlain.setSeed(3);
+    omahaPlain.runSimulation();
+    MonteCarloSimulator omaha(omahaHand, flop, 20000, GameVariant::Omaha);
+    omaha.setVarianceReduction(MonteCarloSimulator::VarianceReduction::all());
+    omaha.setSeed(3);
+    omaha.runSimulation();
+    ASSERT_NEAR(omaha.getWinPercentage(), omahaPlain.getWinPercentage(),
+                4 * (omaha.getWinRateStdDev() + omahaPlain.getWinRateStdDev()));
+
+    // More than one opponent samples plainly
+    MonteCarloSimulator multiway(hand, turn, 5000, GameVariant::Holdem, 2);
+    multiway.setVarianceReduction(MonteCarloSimulator::VarianceReduction::all());
+    multiway.runSimulation();
+    ASSERT_NEAR(multiway.getEffectiveSampleSize(), 5000.0, 1e-9);
+}
+
+// Test: Quasi-random sampling is unbiased, deterministic and reports its error
+TEST(quasi_random_sampler) {
+    // Every point of the sequence deals distinct live cards
+    CardSet dead;
+    dead.add(Card(Rank::Ace, Suit::Spades));
+    KroneckerDeck sequence(GameVariant::Holdem, dead, 7);
+    const uint64_t shift[7] = {1, 2, 3, 4, 5, 6, 7};
+    sequence.start(shift, 0);
+    for (int point = 0; point < 100; ++point) {
+        sequence.reset();
+        CardSet dealt = sequence.deal(7);
+        ASSERT_TRUE(dealt.size() == 7);
+        ASSERT_TRUE(!dealt.intersects(dead));
+    }
+    bool threw = false;
+    try {
+        sequence.dealId();
+    } catch (const std::out_of_range &) {
+        threw = true;
+    }
+    ASSERT_TRUE(threw);
+
+    std::vector<Card> hand = {Card(Rank::Ace, Suit::Clubs), Card(Rank::Ten, Suit::Clubs)};
+    std::vector<Card> turn = {Card(Rank::Ten, Suit::Hearts), Card(Rank::Six, Suit::Clubs),
+                              Card(Rank::Two, Suit::Clubs), Card(Rank::King, Suit::Spades)};
+
+    MonteCarloSimulator exact(hand, turn, 1000);
+    exact.setMode(MonteCarloSimulator::Mode::Exact);
+    exact.runSimulation();
+
+    MonteCarloSimulator quasi(hand, turn, 20000);
+    quasi.setMode(MonteCarloSimulator::Mode::Sample);
+    quasi.setSampler(MonteCarloSimulator::Sampler::QuasiRandom);
+    quasi.setSeed(5);
+    quasi.runSimulation();
+
+    ASSERT_TRUE(quasi.getSampleSize() == 20000);
+    ASSERT_TRUE(quasi.getWinRateStdDev() > 0.0);
+    ASSERT_NEAR(quasi.getWinPercentage(), exact.getWinPercentage(), 0.01);
+    ASSERT_NEAR(quasi.getEquity(), exact.getEquity(), 0.01);
+
+    // Chunks continue their replicate by number, whoever runs them
+    MonteCarloSimulator oneThread(hand, turn, 20000);
+    oneThread.setMode(MonteCarloSimulator::Mode::Sample);
+    oneThread.setSampler(MonteCarloSimulator::Sampler::QuasiRandom);
+    oneThread.setSeed(5);
+    oneThread.setThreadCount(1);
+    oneThread.runSimulation();
+    ASSERT_TRUE(oneThread.getWinPercentage() == quasi.getWinPercentage());
+
+    // Omaha against two opponents deals more coordinates per point
+    std::vector<Card> omahaHand = {Card(Rank::Ace, Suit::Clubs), Card(Rank::Ten, Suit::Clubs),
+                                   Card(Rank::Three, Suit::Spades), Card(Rank::Five, Suit::Hearts)};
+    std::vector<Card> flop(turn.begin(), turn.end() - 1);
+    MonteCarloSimulator omahaPlain(omahaHand, flop, 20000, GameVariant::Omaha, 2);
+    omahaPlain.setSeed(3);
+    omahaPlain.runSimulation();
+    MonteCarloSimulator omaha(omahaHand, flop, 20000, GameVariant::Omaha, 2);
+    omaha.setSampler(MonteCarloSimulator::Sampler::QuasiRandom);
+    omaha.setSeed(3);
+    omaha.runSimulation();
+    ASSERT_NEAR(omaha.getWinPercentage(), omahaPlain.getWinPercentage(),
+                4 * (omaha.getWinRateStdDev() + omahaPlain.getWinRateStdDev()));
 }
 
 int main() {
@@ -180,6 +871,19 @@ int main() {
     RUN_TEST(royal_flush_wins);
     RUN_TEST(high_pair_beats_random);
     RUN_TEST(confidence_interval_scaling);
+    RUN_TEST(omaha_simulation);
+    RUN_TEST(short_deck_simulation);
+    RUN_TEST(hi_lo_simulation);
+    RUN_TEST(deck_partial_shuffle);
+    RUN_TEST(rng_streams);
+    RUN_TEST(deal_generator_replays);
+    RUN_TEST(work_stealing_pool);
+    RUN_TEST(parallel_simulation_is_deterministic);
+    RUN_TEST(multiway_equity);
+    RUN_TEST(exact_enumeration);
+    RUN_TEST(adaptive_stopping);
+    RUN_TEST(variance_reduction);
+    RUN_TEST(quasi_random_sampler);
     
     std::cout << "\n✓ All tests passed!\n";
     return 0;
@@ -0,0 +1,262 @@
+/**
+ * Evaluator Benchmark
+ *
+ * Enumerates all C(52,7) = 133,784,560 seven-card hands with every
+ * evaluator implementation, on all cores, and checks that each one
+ * produces the known per-category totals and the same per-hand scores.
+ * Prints hands per second so throughput can be compared across releases.
+ *
+ * Every backend in EvaluatorRegistry::available() is timed on its batch
+ * entry point. Each block of hands shares its first five cards, which
+ * also times evaluateAgainstBoard with those five as the board.
+ *
+ * Usage: bench_evaluator [--reference]
+ *   --reference  also run AdvancedHandEvaluator::evaluateReference (slow)
+ *
+ * Per-hand agreement is checked with an order-independent checksum that
+ * mixes each hand's cards with its score; every implementation must match
+ * the bitmask evaluator's checksum. Exits non-zero on any mismatch.
+ */
+
+#include "../model/advanced_hand_evaluator.h"
+#include "../model/bitmask_hand_evaluator.h"
+#include "../model/evaluator_registry.h"
+#include "../model/fixed_hand_evaluator.h"
+#include "../model/lookup_table_evaluator.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <thread>
+#include <vector>
+
+static const uint64_t TOTAL_HANDS = 133784560;
+
+// Known 7-card totals, indexed by HandRank
+static const uint64_t EXPECTED[10] = {
+    23294460, // High Card
+    58627800, // One Pair
+    31433400, // Two Pair
+    6461620,  // Three of a Kind
+    6180020,  // Straight
+    4047644,  // Flush
+    3473184,  // Full House
+    224848,   // Four of a Kind
+    37260,    // Straight Flush (excluding royal)
+    4324      // Royal Flush
+};
+
+static const char *CATEGORY_NAMES[10] = {
+    "High Card", "One Pair", "Two Pair", "Three of a Kind", "Straight",
+    "Flush", "Full House", "Four of a Kind", "Straight Flush", "Royal Flush"};
+
+// All hands sharing their first five cards, scored in one call
+struct HandBlock
+{
+    static const int CAPACITY = 47 * 46 / 2;
+
+    CardSet sets[CAPACITY];
+    std::array<CardId, 7> ids[CAPACITY];
+    uint32_t scores[CAPACITY];
+    int count = 0;
+};
+
+using BlockEvaluator = std::function<void(HandBlock &)>;
+
+struct NamedEvaluator
+{
+    const char *name;
+    BlockEvaluator evaluate;
+};
+
+struct Tally
+{
+    uint64_t counts[10] = {};
+    uint64_t checksum = 0;
+};
+
+/**
+ * Enumerate every hand whose first two cards form work item (a, b); the
+ * items are handed out dynamically so threads stay balanced.
+ */
+static void enumerate(const BlockEvaluator &evaluate, std::atomic<int> &nextItem, Tally &tally)
+{
+    HandBlock *block = new HandBlock;
+    for (int item = nextItem++; item < 52 * 52; item = nextItem++)
+    {
+        int a = item / 52, b = item % 52;
+        if (b <= a)
+            continue;
+        CardSet ab = CardSet::of(a) | CardSet::of(b);
+
+        for (int c = b + 1; c < 52; ++c)
+        {
+            CardSet abc = ab | CardSet::of(c);
+            for (int d = c + 1; d < 52; ++d)
+            {
+                CardSet abcd = abc | CardSet::of(d);
+                for (int e = d + 1; e < 52; ++e)
+                {
+                    CardSet five = abcd | CardSet::of(e);
+                    block->count = 0;
+                    for (int f = e + 1; f < 52; ++f)
+                    {
+                        CardSet six = five | CardSet::of(f);
+                        for (int g = f + 1; g < 52; ++g)
+                        {
+                            int n = block->count++;
+                            block->sets[n] = six | CardSet::of(g);
+                            block->ids[n] = {CardId(a), CardId(b), CardId(c), CardId(d),
+                                             CardId(e), CardId(f), CardId(g)};
+                        }
+                    }
+                    if (block->count == 0)
+                        continue;
+
+                    evaluate(*block);
+                    for (int i = 0; i < block->count; ++i)
+                    {
+                        uint32_t score = block->scores[i];
+                        tally.counts[score >> HandValue::CATEGORY_SHIFT]++;
+                        tally.checksum += (block->sets[i].bits * 0x9E3779B97F4A7C15ull) ^ score;
+                    }
+                }
+            }
+        }
+    }
+    delete block;
+}
+
+struct Result
+{
+    Tally tally;
+    double seconds = 0.0;
+};
+
+static Result run(const BlockEvaluator &evaluate, unsigned threads)
+{
+    std::atomic<int> nextItem(0);
+    std::vector<Tally> tallies(threads);
+    std::vector<std::thread> workers;
+
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned t = 0; t < threads; ++t)
+        workers.emplace_back(enumerate, std::cref(evaluate), std::ref(nextItem), std::ref(tallies[t]));
+    for (std::thread &w : workers)
+        w.join();
+    auto end = std::chrono::steady_clock::now();
+
+    Result result;
+    result.seconds = std::chrono::duration<double>(end - start).count();
+    for (const Tally &t : tallies)
+    {
+        for (int i = 0; i < 10; ++i)
+            result.tally.counts[i] += t.counts[i];
+        result.tally.checksum += t.checksum;
+    }
+    return result;
+}
+
+int main(int argc, char *argv[])
+{
+    bool withReference = argc > 1 && std::strcmp(argv[1], "--reference") == 0;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+
+    std::vector<NamedEvaluator> evaluators;
+    evaluators.push_back({"bitmask", [](HandBlock &b) {
+        for (int i = 0; i < b.count; ++i)
+            b.scores[i] = BitmaskHandEvaluator::evaluate(b.sets[i]);
+    }});
+    evaluators.push_back({"evaluate<7>", [](HandBlock &b) {
+        for (int i = 0; i < b.count; ++i)
+            b.scores[i] = FixedHandEvaluator::evaluate(b.ids[i]);
+    }});
+    for (const EvaluatorBackend *backend : EvaluatorRegistry::available())
+    {
+        evaluators.push_back({backend->name(), [backend](HandBlock &b) {
+            backend->evaluateBatch(b.sets, b.scores, b.count);
+        }});
+    }
+    evaluators.push_back({"evaluateAgainstBoard", [](HandBlock &b) {
+        // Every hand in a block shares its first five cards
+        HolePair holes[HandBlock::CAPACITY];
+        CardSet board;
+        for (int k = 0; k < 5; ++k)
+            board |= CardSet::of(b.ids[0][k]);
+        for (int i = 0; i < b.count; ++i)
+            holes[i] = {b.ids[i][5], b.ids[i][6]};
+        AdvancedHandEvaluator::evaluateAgainstBoard(board, holes, b.scores, b.count);
+    }});
+    if (LookupTableEvaluator::isLoaded())
+    {
+        evaluators.push_back({"lookup table (CardIds)", [](HandBlock &b) {
+            for (int i = 0; i < b.count; ++i)
+                b.scores[i] = LookupTableEvaluator::evaluate(b.ids[i].data(), 7);
+        }});
+    }
+    else
+    {
+        std::printf("Lookup table not found (run `make hand_table`), skipping it\n");
+    }
+    evaluators.push_back({"AdvancedHandEvaluator::evaluate", [](HandBlock &b) {
+        std::vector<Card> cards;
+        for (int i = 0; i < b.count; ++i)
+        {
+            cards.clear();
+            for (CardId id : b.ids[i])
+                cards.push_back(cardOf(id));
+            b.scores[i] = AdvancedHandEvaluator::evaluate(cards).score;
+        }
+    }});
+    if (withReference)
+    {
+        evaluators.push_back({"evaluateReference", [](HandBlock &b) {
+            std::vector<Card> cards;
+            for (int i = 0; i < b.count; ++i)
+            {
+                cards.clear();
+                for (CardId id : b.ids[i])
+                    cards.push_back(cardOf(id));
+                b.scores[i] = AdvancedHandEvaluator::evaluateReference(cards).score;
+            }
+        }});
+    }
+
+    std::printf("Enumerating %llu seven-card hands on %u thread(s)\n\n",
+                static_cast<unsigned long long>(TOTAL_HANDS), threads);
+    std::printf("%-32s %10s %14s  %s\n", "Evaluator", "Seconds", "Hands/sec", "Check");
+
+    bool allOk = true;
+    uint64_t baseline = 0;
+    Tally first;
+    for (size_t e = 0; e < evaluators.size(); ++e)
+    {
+        Result r = run(evaluators[e].evaluate, threads);
+        if (e == 0)
+        {
+            baseline = r.tally.checksum;
+            first = r.tally;
+        }
+
+        bool countsOk = std::equal(r.tally.counts, r.tally.counts + 10, EXPECTED);
+        bool scoresOk = r.tally.checksum == baseline;
+        allOk = allOk && countsOk && scoresOk;
+
+        std::printf("%-32s %10.2f %14.0f  %s\n", evaluators[e].name, r.seconds,
+                    TOTAL_HANDS / r.seconds,
+                    !countsOk ? "FAIL (category counts)" : !scoresOk ? "FAIL (scores differ)" : "OK");
+    }
+
+    std::printf("\n%-16s %12s %12s\n", "Category", "Counted", "Expected");
+    for (int i = 9; i >= 0; --i)
+        std::printf("%-16s %12llu %12llu\n", CATEGORY_NAMES[i],
+                    static_cast<unsigned long long>(first.counts[i]),
+                    static_cast<unsigned long long>(EXPECTED[i]));
+
+    std::printf("\n%s\n", allOk ? "All evaluators verified" : "VERIFICATION FAILED");
+    return allOk ? 0 : 1;
+}
@@ -0,0 +1,196 @@
+/**
+ * Hand Table Generator
+ *
+ * Builds the state-transition table read by LookupTableEvaluator and writes
+ * it to disk (default: hand_ranks.dat, or the path given as argv[1]).
+ *
+ * A state is the sorted list of cards seen so far, one byte per card:
+ * rank << 3 | suit, where suit 1-4 is kept only while that suit can still
+ * reach five cards by the 7th card and is dropped to 0 otherwise. Dropping
+ * irrelevant suits is what keeps the table to ~600k states instead of the
+ * ~23M raw card subsets.
+ */
+
+#include "../model/bitmask_hand_evaluator.h"
+#include "../model/lookup_table_evaluator.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <unordered_map>
+#include <vector>
+
+static const int MAX_CARDS = 7;
+
+static void unpack(uint64_t key, int count, uint8_t *cards)
+{
+    for (int i = 0; i < count; ++i)
+        cards[i] = static_cast<uint8_t>(key >> (8 * i));
+}
+
+static uint64_t pack(const uint8_t *cards, int count)
+{
+    uint64_t key = 0;
+    for (int i = 0; i < count; ++i)
+        key |= static_cast<uint64_t>(cards[i]) << (8 * i);
+    return key;
+}
+
+/**
+ * Score the cards of a state with the bitmask evaluator's mask entry point
+ */
+static uint32_t scoreOf(const uint8_t *cards, int count)
+{
+    int rankCount[13] = {};
+    int suitCount[5] = {};
+    uint32_t suitRanks[5] = {};
+    for (int i = 0; i < count; ++i)
+    {
+        int rank = (cards[i] >> 3) - 2;
+        int suit = cards[i] & 7;
+        rankCount[rank]++;
+        if (suit)
+        {
+            suitCount[suit]++;
+            suitRanks[suit] |= 1u << rank;
+        }
+    }
+
+    uint32_t atLeast[5] = {};
+    for (int r = 0; r < 13; ++r)
+        for (int n = 1; n <= rankCount[r]; ++n)
+            atLeast[n] |= 1u << r;
+
+    uint32_t flush = 0;
+    for (int s = 1; s <= 4; ++s)
+        if (suitCount[s] >= 5)
+            flush = suitRanks[s];
+
+    return BitmaskHandEvaluator::evaluateMasks(atLeast[1], atLeast[2], atLeast[3], atLeast[4], flush);
+}
+
+/**
+ * Add a card to a state; returns 0 for impossible hands (duplicate card,
+ * five of a rank). `cards` receives the normalised card bytes.
+ */
+static uint64_t addCard(uint64_t key, int count, CardId id, uint8_t *cards)
+{
+    unpack(key, count, cards);
+
+    int rank = id % 13 + 2;
+    int suit = id / 13 + 1;
+    uint8_t card = static_cast<uint8_t>(rank << 3 | suit);
+
+    int sameRank = 0;
+    for (int i = 0; i < count; ++i)
+    {
+        if (cards[i] == card)
+            return 0;
+        if ((cards[i] >> 3) == rank)
+            sameRank++;
+    }
+    if (sameRank >= 4)
+        return 0;
+
+    cards[count++] = card;
+
+    // Forget suits that can no longer make a flush
+    int suitCount[5] = {};
+    for (int i = 0; i < count; ++i)
+        suitCount[cards[i] & 7]++;
+    for (int i = 0; i < count; ++i)
+    {
+        int s = cards[i] & 7;
+        if (s && suitCount[s] + (MAX_CARDS - count) < 5)
+            cards[i] &= ~7;
+    }
+
+    // Insertion sort, highest card first (at most 7 bytes)
+    for (int i = 1; i < count; ++i)
+        for (int j = i; j > 0 && cards[j - 1] < cards[j]; --j)
+            std::swap(cards[j - 1], cards[j]);
+    return pack(cards, count);
+}
+
+int main(int argc, char *argv[])
+{
+    std::string path = argc > 1 ? argv[1] : LookupTableEvaluator::defaultPath();
+    const uint32_t STATE_SIZE = LookupTableEvaluator::STATE_SIZE;
+
+    auto start = std::chrono::steady_clock::now();
+
+    // Block 0 is left empty so that 0 can mean "no such state"
+    std::vector<uint64_t> keys = {0, 0};
+    std::vector<uint8_t> sizes = {0, 0};
+    std::unordered_map<uint64_t, uint32_t> stateIndex;
+    std::vector<uint32_t> table(2 * STATE_SIZE, 0);
+
+    uint8_t cards[MAX_CARDS];
+    for (size_t state = 1; state < keys.size(); ++state)
+    {
+        uint64_t key = keys[state];
+        int count = sizes[state];
+        uint32_t *block = &table[state * STATE_SIZE];
+
+        if (count >= 5)
+        {
+            unpack(key, count, cards);
+            block[0] = scoreOf(cards, count);
+        }
+
+        for (CardId id = 0; id < 52; ++id)
+        {
+            uint64_t next = addCard(key, count, id, cards);
+            if (next == 0)
+                continue;
+
+            if (count + 1 == MAX_CARDS)
+            {
+                table[state * STATE_SIZE + id + 1] = scoreOf(cards, MAX_CARDS);
+                continue;
+            }
+
+            auto it = stateIndex.find(next);
+            uint32_t index;
+            if (it != stateIndex.end())
+            {
+                index = it->second;
+            }
+            else
+            {
+                index = static_cast<uint32_t>(keys.size());
+                stateIndex.emplace(next, index);
+                keys.push_back(next);
+                sizes.push_back(static_cast<uint8_t>(count + 1));
+                table.resize(table.size() + STATE_SIZE, 0);
+            }
+            table[state * STATE_SIZE + id + 1] = index * STATE_SIZE;
+        }
+    }
+
+    LookupTableEvaluator::FileHeader header = {};
+    std::copy(std::begin(LookupTableEvaluator::MAGIC), std::end(LookupTableEvaluator::MAGIC), header.magic);
+    header.version = LookupTableEvaluator::TABLE_VERSION;
+    header.entryCount = table.size();
+
+    FILE *out = std::fopen(path.c_str(), "wb");
+    if (!out)
+    {
+        std::cerr << "Error: cannot open " << path << " for writing\n";
+        return 1;
+    }
+    bool ok = std::fwrite(&header, sizeof(header), 1, out) == 1 &&
+              std::fwrite(table.data(), sizeof(uint32_t), table.size(), out) == table.size();
+    ok = (std::fclose(out) == 0) && ok;
+    if (!ok)
+    {
+        std::cerr << "Error: failed writing " << path << "\n";
+        return 1;
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Wrote " << path << ": " << keys.size() - 1 << " states, "
+              << table.size() << " entries (" << table.size() * sizeof(uint32_t) / (1024 * 1024)
+              << " MB) in " << seconds << "s\n";
+    return 0;
+}
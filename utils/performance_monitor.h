@@ -2,6 +2,7 @@
 #define PERFORMANCE_MONITOR_H
 
 #include <chrono>
+#include <climits>
 #include <string>
 #include <map>
 #include <iostream>
@@ -40,7 +41,7 @@ public:
     static void stop(const std::string& operationName) {
         auto endTime = Clock::now();
         auto it = activeTimers.find(operationName);
-        if (it == activeTimers.end()) {
+        if (it == activeTimers.end() || it->second == TimePoint{}) {
             std::cerr << "Warning: No active timer for " << operationName << "\n";
             return;
         }
@@ -54,7 +55,9 @@ public:
         m.minMicroseconds = std::min(m.minMicroseconds, micros);
         m.maxMicroseconds = std::max(m.maxMicroseconds, micros);
         
-        activeTimers.erase(it);
+        // Keep the entry so the next start() of a repeated operation
+        // reuses its node instead of allocating a new one
+        it->second = TimePoint{};
     }
     
     // Get average time in milliseconds
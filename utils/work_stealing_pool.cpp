@@ -0,0 +1,156 @@
+// work_stealing_pool.cpp
+#include "work_stealing_pool.h"
+#include <algorithm>
+
+WorkStealingPool::WorkStealingPool(unsigned workers)
+{
+    if (workers == 0)
+        workers = std::max(1u, std::thread::hardware_concurrency());
+
+    for (unsigned w = 0; w < workers; ++w)
+        slots.push_back(std::make_unique<Slot>());
+    for (unsigned w = 1; w < workers; ++w)
+        threads.emplace_back(&WorkStealingPool::workerLoop, this, w);
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    {
+        std::lock_guard<std::mutex> guard(stateLock);
+        stopping = true;
+    }
+    started.notify_all();
+    for (std::thread &t : threads)
+        t.join();
+}
+
+WorkStealingPool &WorkStealingPool::shared()
+{
+    static WorkStealingPool pool;
+    return pool;
+}
+
+void WorkStealingPool::run(size_t count, const Task &fn, unsigned maxWorkers)
+{
+    if (count == 0)
+        return;
+
+    std::lock_guard<std::mutex> serial(runLock);
+
+    unsigned workers = maxWorkers == 0 ? size() : std::min(maxWorkers, size());
+    workers = static_cast<unsigned>(std::min<size_t>(workers, count));
+
+    // Too little to share: run it here without waking anyone
+    if (workers == 1)
+    {
+        for (size_t i = 0; i < count; ++i)
+            fn(i, 0);
+        return;
+    }
+
+    for (unsigned w = 0; w < workers; ++w)
+    {
+        std::lock_guard<std::mutex> guard(slots[w]->lock);
+        slots[w]->begin = count * w / workers;
+        slots[w]->end = count * (w + 1) / workers;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(stateLock);
+        task = &fn;
+        failure = nullptr;
+        active = busy = workers;
+        generation++;
+    }
+    started.notify_all();
+
+    work(0);
+
+    std::unique_lock<std::mutex> guard(stateLock);
+    finished.wait(guard, [&] { return busy == 0; });
+    task = nullptr;
+    if (failure)
+        std::rethrow_exception(failure);
+}
+
+void WorkStealingPool::workerLoop(unsigned worker)
+{
+    uint64_t seen = 0;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> guard(stateLock);
+            started.wait(guard, [&] { return stopping || generation != seen; });
+            if (stopping)
+                return;
+            seen = generation;
+            if (worker >= active)
+                continue;
+        }
+        work(worker);
+    }
+}
+
+// Take and run indices until no worker has any left
+void WorkStealingPool::work(unsigned worker)
+{
+    size_t index;
+    while (take(worker, index) || steal(worker, index))
+    {
+        try
+        {
+            (*task)(index, worker);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> guard(stateLock);
+            if (!failure)
+                failure = std::current_exception();
+        }
+    }
+
+    std::lock_guard<std::mutex> guard(stateLock);
+    if (--busy == 0)
+        finished.notify_one();
+}
+
+bool WorkStealingPool::take(unsigned worker, size_t &index)
+{
+    Slot &own = *slots[worker];
+    std::lock_guard<std::mutex> guard(own.lock);
+    if (own.begin == own.end)
+        return false;
+    index = own.begin++;
+    return true;
+}
+
+/**
+ * Move the back half of the first non-empty share found, scanning from the
+ * next worker on, into this worker's share and run its first index
+ */
+bool WorkStealingPool::steal(unsigned worker, size_t &index)
+{
+    for (unsigned step = 1; step < active; ++step)
+    {
+        Slot &victim = *slots[(worker + step) % active];
+        size_t begin, end;
+        {
+            std::lock_guard<std::mutex> guard(victim.lock);
+            size_t left = victim.end - victim.begin;
+            if (left == 0)
+                continue;
+            begin = victim.end - (left + 1) / 2;
+            end = victim.end;
+            victim.end = begin;
+        }
+
+        // Only this worker adds to its own share, and it is empty here
+        Slot &own = *slots[worker];
+        std::lock_guard<std::mutex> guard(own.lock);
+        own.begin = begin + 1;
+        own.end = end;
+        index = begin;
+        return true;
+    }
+    return false;
+}
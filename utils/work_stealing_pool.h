@@ -0,0 +1,78 @@
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * WorkStealingPool - runs numbered tasks on a fixed set of threads
+ *
+ * run(count, task) calls task(index, worker) once for every index in
+ * [0, count) and returns when all calls are done. Each worker starts with
+ * an equal, contiguous share of the indices and takes them from the front;
+ * a worker that runs dry steals the back half of another worker's share,
+ * so uneven tasks still finish together. `worker` is below size() and no
+ * two calls with the same worker overlap, so per-worker scratch space and
+ * counters need no locking.
+ *
+ * The calling thread is worker 0, so a pool of N workers starts N - 1
+ * threads. run() calls are serialized; a task must not call run() itself.
+ */
+class WorkStealingPool
+{
+public:
+    using Task = std::function<void(size_t index, unsigned worker)>;
+
+    // `workers` of 0 means one per hardware thread
+    explicit WorkStealingPool(unsigned workers = 0);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool &) = delete;
+    WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+    // One worker per hardware thread, started on first use
+    static WorkStealingPool &shared();
+
+    unsigned size() const { return static_cast<unsigned>(slots.size()); }
+
+    // Run every index on at most `maxWorkers` workers (0 = all of them);
+    // the first exception a task throws is rethrown here
+    void run(size_t count, const Task &task, unsigned maxWorkers = 0);
+
+private:
+    // Indices [begin, end) still owned by one worker, on its own cache line
+    struct alignas(64) Slot
+    {
+        std::mutex lock;
+        size_t begin = 0;
+        size_t end = 0;
+    };
+
+    std::vector<std::unique_ptr<Slot>> slots;
+    std::vector<std::thread> threads;
+
+    std::mutex runLock;             // one run() at a time
+    std::mutex stateLock;           // guards everything below
+    std::condition_variable started;
+    std::condition_variable finished;
+    uint64_t generation = 0;        // bumped by every run()
+    unsigned active = 0;            // workers taking part in this run
+    unsigned busy = 0;              // of those, still working
+    bool stopping = false;
+    const Task *task = nullptr;
+    std::exception_ptr failure;
+
+    void workerLoop(unsigned worker);
+    void work(unsigned worker);
+    bool take(unsigned worker, size_t &index);
+    bool steal(unsigned worker, size_t &index);
+};
+
+#endif // WORK_STEALING_POOL_H
@@ -9,10 +9,10 @@
 #define BLACK "\033[30m"
 #define WHITE_BG "\033[47m"
 
-void ASCIIArt::drawTable(const std::vector<Card> &communityCards,
+void ASCIIArt::drawTable(CardSpan communityCards,
                          bool showBotCards,
-                         const std::vector<Card> &playerCards,
-                         const std::vector<Card> &botCards)
+                         CardSpan playerCards,
+                         CardSpan botCards)
 {
     std::cout << "\n\n";
     std::cout << "  +-----------------------------------------------------+\n";
@@ -171,7 +171,7 @@ void ASCIIArt::drawHiddenCard()
     std::cout << WHITE_BG << BLACK << "[░░]" << RESET;
 }
 
-void ASCIIArt::drawCards(const std::vector<Card> &cards)
+void ASCIIArt::drawCards(CardSpan cards)
 {
     for (const auto &card : cards)
     {
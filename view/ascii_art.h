@@ -5,21 +5,22 @@
 #include <string>
 #include <vector>
 #include "../model/card.h"
+#include "../model/card_list.h"
 
 class ASCIIArt
 {
 public:
     // Draw the poker table with cards
-    static void drawTable(const std::vector<Card> &communityCards,
+    static void drawTable(CardSpan communityCards,
                           bool showBotCards = false,
-                          const std::vector<Card> &playerCards = {},
-                          const std::vector<Card> &botCards = {});
+                          CardSpan playerCards = {},
+                          CardSpan botCards = {});
 
     // Draw individual card
     static void drawCard(const Card &card);
 
     // Draw a set of cards in a row
-    static void drawCards(const std::vector<Card> &cards);
+    static void drawCards(CardSpan cards);
 
     // Draw poker logo
     static void drawLogo();
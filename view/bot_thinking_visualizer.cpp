@@ -36,7 +36,7 @@ void BotThinkingVisualizer::showThinkingHeader(const std::string& botName, const
     OUT << "\n";
 }
 
-void BotThinkingVisualizer::showHandEvaluation(const HandValue& eval, const std::vector<Card>& hand)
+void BotThinkingVisualizer::showHandEvaluation(const HandValue& eval, CardSpan hand)
 {
     OUT << BOLD << YELLOW << "┌─ HAND EVALUATION ─────────────────────────────────┐" << RESET << "\n";
     
@@ -86,7 +86,7 @@ void BotThinkingVisualizer::showHandEvaluation(const HandValue& eval, const std:
 }
 
 void BotThinkingVisualizer::showDrawingHandAnalysis(bool hasFlushDraw, bool hasStraightDraw, 
-                                                    const std::vector<Card>& /* fullHand */)
+                                                    CardSpan /* fullHand */)
 {
     if (!hasFlushDraw && !hasStraightDraw) {
         return; // Don't show if no draws
@@ -137,7 +137,7 @@ void BotThinkingVisualizer::showBluffCalculation(HandRank handRank, int bluffCha
     OUT << MAGENTA << "└───────────────────────────────────────────────────┘" << RESET << "\n\n";
 }
 
-void BotThinkingVisualizer::showFinalDecision(bool shouldCall, const std::string& reasoning)
+void BotThinkingVisualizer::showFinalDecision(bool shouldCall, const char* reasoning)
 {
     OUT << BOLD;
     if (shouldCall) {
@@ -148,7 +148,7 @@ void BotThinkingVisualizer::showFinalDecision(bool shouldCall, const std::string
         OUT << BOLD << RED << "│" << RESET << " ✗ Bot decides to " << BOLD << RED << "FOLD" << RESET << "\n";
     }
     
-    if (!reasoning.empty()) {
+    if (reasoning && *reasoning) {
         OUT << (shouldCall ? GREEN : RED) << "│" << RESET << " Reasoning: " << reasoning << "\n";
     }
     
@@ -4,6 +4,7 @@
 #include <string>
 #include <vector>
 #include "../model/card.h"
+#include "../model/card_list.h"
 #include "../model/hand_types.h"
 #include "bot_thinking_config.h"
 
@@ -14,17 +15,17 @@ public:
     static void showThinkingHeader(const std::string& botName, const std::string& difficulty);
     
     // Show current hand evaluation
-    static void showHandEvaluation(const HandValue& eval, const std::vector<Card>& hand);
+    static void showHandEvaluation(const HandValue& eval, CardSpan hand);
     
     // Show drawing hand analysis
     static void showDrawingHandAnalysis(bool hasFlushDraw, bool hasStraightDraw, 
-                                       const std::vector<Card>& fullHand);
+                                       CardSpan fullHand);
     
     // Show bluff calculation
     static void showBluffCalculation(HandRank handRank, int bluffChance, bool willBluff);
     
     // Show final decision with reasoning
-    static void showFinalDecision(bool shouldCall, const std::string& reasoning);
+    static void showFinalDecision(bool shouldCall, const char* reasoning);
     
     // Show Monte Carlo simulation progress
     static void showMonteCarloHeader(int simulations);
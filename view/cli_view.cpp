@@ -22,7 +22,7 @@ void CLIView::showWelcome()
     std::cout << "🃏 Welcome to Texas Hold'em (CLI Version)\n";
 }
 
-void CLIView::showCommunityCards(const std::vector<Card> &cards, const std::string &stage)
+void CLIView::showCommunityCards(CardSpan cards, const std::string &stage)
 {
     CardAnimation::dealCommunityCards(cards, stage);
 }
@@ -38,7 +38,7 @@ void CLIView::showChipCounts(const Player &p1, const Player &p2)
     ASCIIArt::drawPlayers(p1.getName(), p2.getName(), p1.getChipCount(), p2.getChipCount());
 }
 
-void CLIView::showResult(const Player &p1, const Player &p2, const std::vector<Card> &community)
+void CLIView::showResult(const Player &p1, const Player &p2, CardSpan community)
 {
     std::cout << "\n" << BOLD << YELLOW << "╔════════════════════════════════════════════════════╗" << RESET << "\n";
     std::cout << BOLD << YELLOW << "║" << RESET << "            " << BOLD << CYAN << "🎴 SHOWDOWN 🎴" << RESET << "                    " << BOLD << YELLOW << "║" << RESET << "\n";
@@ -59,7 +59,7 @@ void CLIView::showDivider()
     std::cout << RESET << "\n";
 }
 
-void CLIView::showTable(const std::vector<Card> &community, const Player &human, const Player &bot, bool showBotCards)
+void CLIView::showTable(CardSpan community, const Player &human, const Player &bot, bool showBotCards)
 {
     ASCIIArt::drawTable(community, showBotCards, human.getHand(), bot.getHand());
 }
\ No newline at end of file